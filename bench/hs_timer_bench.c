@@ -0,0 +1,949 @@
+/**
+ * @file      hs_timer_bench.c
+ * @brief     定时器性能测试程序
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 16:08:45
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "hs_timer.h"
+
+#define HS_TIMER_BENCH_NSEC_PER_SEC  (1000000000ULL) // 每秒的纳秒数
+#define HS_TIMER_BENCH_NSEC_PER_MSEC (1000000ULL)    // 每毫秒的纳秒数
+#define HS_TIMER_BENCH_IDLE_NS       (3600ULL * HS_TIMER_BENCH_NSEC_PER_SEC) // 不会到期的超时时间 (单位: ns)
+#define HS_TIMER_BENCH_CHURN_TIMERS  (64U)   // 每个线程反复启动/停止的定时器数量
+#define HS_TIMER_BENCH_MAX_THREADS   (64U)   // 最大线程数
+#define HS_TIMER_BENCH_PROBE_COUNT   (16U)   // 测量延迟的定时器数量
+#define HS_TIMER_BENCH_PROBE_NS      (10ULL * HS_TIMER_BENCH_NSEC_PER_MSEC) // 测量延迟的定时器周期 (单位: ns)
+#define HS_TIMER_BENCH_MAX_SAMPLES   (1U << 16) // POSIX 定时器延迟样本的最大数量
+
+// 对比的实现
+typedef enum hs_timer_bench_backend
+{
+    E_HS_TIMER_BENCH_BACKEND_WHEEL = 0, // hs_timer (时间轮引擎)
+    E_HS_TIMER_BENCH_BACKEND_POSIX,     // 每个定时器一个 POSIX 定时器 (timer_create)
+} hs_timer_bench_backend_e;
+
+// 测试配置
+typedef struct hs_timer_bench_config
+{
+    const char *scenario;         // 只运行该场景 (NULL: 全部)
+    bool quick;                   // 是否使用较小的规模
+    uint32_t max_threads;         // arm/cancel 场景的最大线程数
+    uint64_t run_ns;              // 每个吞吐量/延迟测试的持续时间 (单位: ns)
+    uint64_t drift_ns;            // 周期漂移测试的持续时间 (单位: ns)
+    uint64_t drift_period_ns;     // 周期漂移测试的周期 (单位: ns)
+    uint64_t create_count;        // 创建/销毁场景的定时器数量
+} hs_timer_bench_config_t;
+
+// JSON 输出状态
+typedef struct hs_timer_bench_output
+{
+    uint32_t result_count; // 已输出的结果数量
+} hs_timer_bench_output_t;
+
+// arm/cancel 线程参数
+typedef struct hs_timer_bench_churn
+{
+    hs_timer_bench_backend_e backend; // 实现
+    hs_timer_engine_t *engine;        // 时间轮引擎
+    const bool *start;                // 开始标志
+    const bool *stop;                 // 结束标志
+    uint64_t ops;                     // 完成的操作数
+    int error;                        // 错误码
+    pthread_t thread;                 // 线程
+} hs_timer_bench_churn_t;
+
+// POSIX 定时器的延迟测量
+typedef struct hs_timer_bench_posix_probe
+{
+    timer_t timer;        // 定时器
+    uint64_t deadline_ns; // 本次到期时间 (单位: ns)
+} hs_timer_bench_posix_probe_t;
+
+// 周期漂移测量
+typedef struct hs_timer_bench_drift
+{
+    uint64_t start_ns;    // 启动时间 (单位: ns)
+    uint64_t period_ns;   // 周期 (单位: ns)
+    uint64_t fired;       // 回调次数
+    uint64_t periods;     // 经过的周期数 (包括跳过的)
+    uint64_t last_ns;     // 最近一次回调的时间 (单位: ns)
+    int64_t max_drift_ns; // 回调时间相对理想周期时间的最大偏差 (单位: ns)
+} hs_timer_bench_drift_t;
+
+// POSIX 间隔定时器的周期漂移测量
+typedef struct hs_timer_bench_posix_drift
+{
+    hs_timer_bench_drift_t drift; // 周期漂移测量
+    timer_t timer;                // 定时器
+} hs_timer_bench_posix_drift_t;
+
+static uint64_t s_posix_samples[HS_TIMER_BENCH_MAX_SAMPLES];
+static uint32_t s_posix_sample_count = 0;
+static bool s_posix_probe_stop = false;
+
+/**
+ * @brief 获取 CLOCK_MONOTONIC 当前时间
+ *
+ * @return 当前时间 (单位: ns)
+ */
+static uint64_t hs_timer_bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * HS_TIMER_BENCH_NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 将纳秒转换为 timespec
+ *
+ * @param[in] ns: 时间 (单位: ns)
+ *
+ * @return timespec
+ */
+static struct timespec hs_timer_bench_ns_to_timespec(const uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / HS_TIMER_BENCH_NSEC_PER_SEC);
+    ts.tv_nsec = (long)(ns % HS_TIMER_BENCH_NSEC_PER_SEC);
+
+    return ts;
+}
+
+/**
+ * @brief 获取实现名称
+ *
+ * @param[in] backend: 实现
+ *
+ * @return 名称
+ */
+static const char *hs_timer_bench_backend_name(const hs_timer_bench_backend_e backend)
+{
+    return (backend == E_HS_TIMER_BENCH_BACKEND_WHEEL) ? "wheel" : "posix";
+}
+
+/**
+ * @brief 场景是否需要运行
+ *
+ * @param[in] config  : 测试配置
+ * @param[in] scenario: 场景名称
+ *
+ * @return true : 需要
+ * @return false: 不需要
+ */
+static bool hs_timer_bench_enabled(const hs_timer_bench_config_t *config, const char *scenario)
+{
+    return (config->scenario == NULL) || (strcmp(config->scenario, scenario) == 0);
+}
+
+/**
+ * @brief 开始输出一条结果
+ *
+ * @param[in,out] output  : JSON 输出状态
+ * @param[in]     scenario: 场景名称
+ * @param[in]     backend : 实现
+ */
+static void hs_timer_bench_result_begin(hs_timer_bench_output_t *output, const char *scenario,
+                                        const hs_timer_bench_backend_e backend)
+{
+    printf("%s\n    {\"scenario\": \"%s\", \"backend\": \"%s\"", (output->result_count == 0) ? "" : ",", scenario,
+           hs_timer_bench_backend_name(backend));
+    output->result_count++;
+    fflush(stdout);
+}
+
+/**
+ * @brief 结束输出一条结果
+ *
+ * @param[in] error: 错误码 (0: 成功)
+ */
+static void hs_timer_bench_result_end(const int error)
+{
+    if (error != 0)
+    {
+        printf(", \"error\": \"%s\"", strerror(error));
+    }
+    printf("}");
+    fflush(stdout);
+}
+
+/**
+ * @brief 输出吞吐量
+ *
+ * @param[in] ops       : 操作数
+ * @param[in] elapsed_ns: 耗时 (单位: ns)
+ */
+static void hs_timer_bench_print_rate(const uint64_t ops, const uint64_t elapsed_ns)
+{
+    double seconds = (double)elapsed_ns / (double)HS_TIMER_BENCH_NSEC_PER_SEC;
+    printf(", \"ops\": %llu, \"seconds\": %.6f, \"ops_per_sec\": %.0f", (unsigned long long)ops, seconds,
+           (seconds > 0.0) ? ((double)ops / seconds) : 0.0);
+}
+
+/**
+ * @brief 空回调
+ *
+ * @param[in] hs_timer: 定时器对象
+ */
+static void hs_timer_bench_nop_cb(hs_timer_t *hs_timer)
+{
+    (void)hs_timer;
+}
+
+/**
+ * @brief 等待引擎释放全部定时器
+ *
+ * @note 销毁请求由派发方异步处理
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_bench_wait_released(hs_timer_engine_t *engine)
+{
+    hs_timer_engine_stats_t *stats = (hs_timer_engine_stats_t *)malloc(sizeof(hs_timer_engine_stats_t));
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    while ((hs_timer_engine_get_stats(engine, stats) == 0) && (stats->timer_count != 0))
+    {
+        usleep(1000);
+    }
+    free(stats);
+}
+
+/**
+ * @brief 创建/启动/销毁吞吐量
+ *
+ * @param[in,out] output: JSON 输出状态
+ * @param[in]     config: 测试配置
+ */
+static void hs_timer_bench_create_destroy(hs_timer_bench_output_t *output, const hs_timer_bench_config_t *config)
+{
+    // 时间轮: 包括等待引擎异步释放全部定时器的时间
+    hs_timer_engine_t *engine = hs_timer_engine_create(NULL);
+    hs_timer_bench_result_begin(output, "create_destroy", E_HS_TIMER_BENCH_BACKEND_WHEEL);
+    int error = (engine == NULL) ? ENOMEM : 0;
+    uint64_t ops = 0;
+    uint64_t start_ns = hs_timer_bench_now_ns();
+    for (; (error == 0) && (ops < config->create_count); ops++)
+    {
+        hs_timer_t *hs_timer = hs_timer_create_on(engine);
+        if ((hs_timer == NULL) ||
+            (hs_timer_init_ns(hs_timer, hs_timer_bench_nop_cb, HS_TIMER_REPEAT_ONCE, HS_TIMER_BENCH_IDLE_NS, NULL) != 0) ||
+            (hs_timer_destroy(hs_timer) != 0))
+        {
+            error = ENOMEM;
+        }
+    }
+    if (engine != NULL)
+    {
+        hs_timer_bench_wait_released(engine);
+    }
+    hs_timer_bench_print_rate(ops, hs_timer_bench_now_ns() - start_ns);
+    hs_timer_bench_result_end(error);
+    if (engine != NULL)
+    {
+        hs_timer_engine_destroy(engine);
+    }
+
+    // POSIX: timer_create + timer_settime + timer_delete
+    hs_timer_bench_result_begin(output, "create_destroy", E_HS_TIMER_BENCH_BACKEND_POSIX);
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_NONE;
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value = hs_timer_bench_ns_to_timespec(HS_TIMER_BENCH_IDLE_NS);
+
+    error = 0;
+    ops = 0;
+    start_ns = hs_timer_bench_now_ns();
+    for (; ops < config->create_count; ops++)
+    {
+        timer_t timer;
+        if (timer_create(CLOCK_MONOTONIC, &sev, &timer) != 0)
+        {
+            error = errno;
+
+            break;
+        }
+        timer_settime(timer, 0, &its, NULL);
+        timer_delete(timer);
+    }
+    hs_timer_bench_print_rate(ops, hs_timer_bench_now_ns() - start_ns);
+    hs_timer_bench_result_end(error);
+}
+
+/**
+ * @brief arm/cancel 线程
+ *
+ * @note 每个线程反复启动、停止自己的一组定时器 (超时时间很长，不会到期)
+ *
+ * @param[in,out] arg: 线程参数
+ *
+ * @return NULL
+ */
+static void *hs_timer_bench_churn_thread(void *arg)
+{
+    hs_timer_bench_churn_t *churn = (hs_timer_bench_churn_t *)arg;
+    hs_timer_t *timers[HS_TIMER_BENCH_CHURN_TIMERS] = {0};
+    timer_t posix_timers[HS_TIMER_BENCH_CHURN_TIMERS];
+    uint32_t count = 0;
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_NONE;
+    struct itimerspec arm;
+    memset(&arm, 0, sizeof(arm));
+    arm.it_value = hs_timer_bench_ns_to_timespec(HS_TIMER_BENCH_IDLE_NS);
+    struct itimerspec disarm;
+    memset(&disarm, 0, sizeof(disarm));
+
+    for (; count < HS_TIMER_BENCH_CHURN_TIMERS; count++)
+    {
+        if (churn->backend == E_HS_TIMER_BENCH_BACKEND_WHEEL)
+        {
+            timers[count] = hs_timer_create_on(churn->engine);
+            if ((timers[count] == NULL) || (hs_timer_init_ns(timers[count], hs_timer_bench_nop_cb, HS_TIMER_REPEAT_ONCE,
+                                                             HS_TIMER_BENCH_IDLE_NS, NULL) != 0))
+            {
+                churn->error = ENOMEM;
+
+                break;
+            }
+        }
+        else if (timer_create(CLOCK_MONOTONIC, &sev, &posix_timers[count]) != 0)
+        {
+            churn->error = errno;
+
+            break;
+        }
+    }
+
+    while (!__atomic_load_n(churn->start, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+
+    uint64_t ops = 0;
+    while ((churn->error == 0) && !__atomic_load_n(churn->stop, __ATOMIC_RELAXED))
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (churn->backend == E_HS_TIMER_BENCH_BACKEND_WHEEL)
+            {
+                hs_timer_pause(timers[i]);
+                hs_timer_resume(timers[i]);
+            }
+            else
+            {
+                timer_settime(posix_timers[i], 0, &disarm, NULL);
+                timer_settime(posix_timers[i], 0, &arm, NULL);
+            }
+        }
+        ops += count * 2;
+    }
+    churn->ops = ops;
+
+    if (churn->backend == E_HS_TIMER_BENCH_BACKEND_WHEEL)
+    {
+        hs_timer_destroy_batch(timers, count);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            timer_delete(posix_timers[i]);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 多线程 arm/cancel 吞吐量
+ *
+ * @param[in,out] output: JSON 输出状态
+ * @param[in]     config: 测试配置
+ */
+static void hs_timer_bench_churn(hs_timer_bench_output_t *output, const hs_timer_bench_config_t *config)
+{
+    static hs_timer_bench_churn_t churns[HS_TIMER_BENCH_MAX_THREADS];
+
+    for (uint32_t b = 0; b < 2; b++)
+    {
+        hs_timer_bench_backend_e backend = (hs_timer_bench_backend_e)b;
+        hs_timer_engine_t *engine = NULL;
+        if (backend == E_HS_TIMER_BENCH_BACKEND_WHEEL)
+        {
+            engine = hs_timer_engine_create(NULL);
+            if (engine == NULL)
+            {
+                hs_timer_bench_result_begin(output, "arm_cancel", backend);
+                hs_timer_bench_result_end(ENOMEM);
+
+                continue;
+            }
+        }
+
+        for (uint32_t threads = 1; threads <= config->max_threads; threads *= 2)
+        {
+            bool start = false;
+            bool stop = false;
+            int error = 0;
+            uint32_t started = 0;
+            for (; started < threads; started++)
+            {
+                memset(&churns[started], 0, sizeof(hs_timer_bench_churn_t));
+                churns[started].backend = backend;
+                churns[started].engine = engine;
+                churns[started].start = &start;
+                churns[started].stop = &stop;
+                if (pthread_create(&churns[started].thread, NULL, hs_timer_bench_churn_thread, &churns[started]) != 0)
+                {
+                    error = EAGAIN;
+
+                    break;
+                }
+            }
+
+            uint64_t start_ns = hs_timer_bench_now_ns();
+            __atomic_store_n(&start, true, __ATOMIC_RELEASE);
+            struct timespec ts = hs_timer_bench_ns_to_timespec(config->run_ns);
+            nanosleep(&ts, NULL);
+            __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+
+            uint64_t ops = 0;
+            for (uint32_t i = 0; i < started; i++)
+            {
+                pthread_join(churns[i].thread, NULL);
+                ops += churns[i].ops;
+                if (churns[i].error != 0)
+                {
+                    error = churns[i].error;
+                }
+            }
+
+            hs_timer_bench_result_begin(output, "arm_cancel", backend);
+            printf(", \"threads\": %u", threads);
+            hs_timer_bench_print_rate(ops, hs_timer_bench_now_ns() - start_ns);
+            hs_timer_bench_result_end(error);
+        }
+
+        if (engine != NULL)
+        {
+            hs_timer_bench_wait_released(engine);
+            hs_timer_engine_destroy(engine);
+        }
+    }
+}
+
+/**
+ * @brief 比较样本大小 (qsort 使用)
+ *
+ * @param[in] a: 样本
+ * @param[in] b: 样本
+ *
+ * @return 比较结果
+ */
+static int hs_timer_bench_compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief POSIX 测量定时器的回调
+ *
+ * @note 到期后按上一次的到期时间加周期重新启动，不累积漂移
+ *
+ * @param[in] value: 测量定时器
+ */
+static void hs_timer_bench_posix_probe_cb(union sigval value)
+{
+    hs_timer_bench_posix_probe_t *probe = (hs_timer_bench_posix_probe_t *)value.sival_ptr;
+    uint64_t now_ns = hs_timer_bench_now_ns();
+
+    uint32_t index = __atomic_fetch_add(&s_posix_sample_count, 1, __ATOMIC_RELAXED);
+    if (index < HS_TIMER_BENCH_MAX_SAMPLES)
+    {
+        s_posix_samples[index] = (now_ns > probe->deadline_ns) ? (now_ns - probe->deadline_ns) : 0;
+    }
+
+    if (__atomic_load_n(&s_posix_probe_stop, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    probe->deadline_ns += HS_TIMER_BENCH_PROBE_NS;
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value = hs_timer_bench_ns_to_timespec(probe->deadline_ns);
+    timer_settime(probe->timer, TIMER_ABSTIME, &its, NULL);
+}
+
+/**
+ * @brief 时间轮在不同数量的等待定时器下的到期延迟
+ *
+ * @param[in,out] output : JSON 输出状态
+ * @param[in]     config : 测试配置
+ * @param[in]     pending: 等待中 (不会到期) 的定时器数量
+ */
+static void hs_timer_bench_lateness_wheel(hs_timer_bench_output_t *output, const hs_timer_bench_config_t *config,
+                                          const uint64_t pending)
+{
+    hs_timer_engine_config_t engine_config;
+    hs_timer_engine_config_init(&engine_config);
+    engine_config.worker_count = 1;
+    hs_timer_engine_t *engine = hs_timer_engine_create(&engine_config);
+    hs_timer_t **timers = (hs_timer_t **)calloc(pending + HS_TIMER_BENCH_PROBE_COUNT, sizeof(hs_timer_t *));
+    hs_timer_engine_stats_t *stats = (hs_timer_engine_stats_t *)calloc(1, sizeof(hs_timer_engine_stats_t));
+
+    int error = ((engine == NULL) || (timers == NULL) || (stats == NULL)) ? ENOMEM : 0;
+    uint64_t count = 0;
+    for (; (error == 0) && (count < pending + HS_TIMER_BENCH_PROBE_COUNT); count++)
+    {
+        // 等待中的定时器处理完之后再启动测量定时器，启动阶段不计入延迟
+        bool is_probe = (count >= pending);
+        if (is_probe && (count == pending))
+        {
+            usleep(100000);
+        }
+
+        // 等待中的定时器到期时间分散在整个时间轮上，测量定时器按绝对周期到期
+        timers[count] = hs_timer_create_on(engine);
+        if ((timers[count] == NULL) ||
+            (is_probe && (hs_timer_set_periodic_mode(timers[count], E_HS_TIMER_PERIODIC_SKIP) != 0)) ||
+            (hs_timer_init_ns(timers[count], hs_timer_bench_nop_cb,
+                              is_probe ? HS_TIMER_REPEAT_FOREVER : HS_TIMER_REPEAT_ONCE,
+                              is_probe ? HS_TIMER_BENCH_PROBE_NS
+                                       : (HS_TIMER_BENCH_IDLE_NS + (count % 4096) * HS_TIMER_BENCH_NSEC_PER_SEC),
+                              NULL) != 0))
+        {
+            error = ENOMEM;
+
+            break;
+        }
+    }
+
+    if (error == 0)
+    {
+        struct timespec ts = hs_timer_bench_ns_to_timespec(config->run_ns);
+        nanosleep(&ts, NULL);
+        hs_timer_engine_get_stats(engine, stats);
+    }
+
+    hs_timer_bench_result_begin(output, "lateness", E_HS_TIMER_BENCH_BACKEND_WHEEL);
+    printf(", \"pending\": %llu", (unsigned long long)pending);
+    if (error == 0)
+    {
+        printf(", \"tick_ns\": %llu, \"samples\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, "
+               "\"max_ns\": %llu",
+               (unsigned long long)HS_TIMER_ENGINE_DEFAULT_TICK_NS,
+               (unsigned long long)stats->expired_count,
+               (unsigned long long)hs_timer_histogram_percentile(&stats->lateness, 50.0),
+               (unsigned long long)hs_timer_histogram_percentile(&stats->lateness, 99.0),
+               (unsigned long long)hs_timer_histogram_percentile(&stats->lateness, 99.9),
+               (unsigned long long)stats->lateness.max_ns);
+    }
+    hs_timer_bench_result_end(error);
+
+    if (timers != NULL)
+    {
+        hs_timer_destroy_batch(timers, count);
+    }
+    if (engine != NULL)
+    {
+        hs_timer_bench_wait_released(engine);
+        hs_timer_engine_destroy(engine);
+    }
+    free(stats);
+    free(timers);
+}
+
+/**
+ * @brief POSIX 定时器在不同数量的等待定时器下的到期延迟
+ *
+ * @note 每个定时器占用一个内核定时器，受 RLIMIT_SIGPENDING 限制，数量过多时会创建失败
+ *
+ * @param[in,out] output : JSON 输出状态
+ * @param[in]     config : 测试配置
+ * @param[in]     pending: 等待中 (不会到期) 的定时器数量
+ */
+static void hs_timer_bench_lateness_posix(hs_timer_bench_output_t *output, const hs_timer_bench_config_t *config,
+                                          const uint64_t pending)
+{
+    static hs_timer_bench_posix_probe_t probes[HS_TIMER_BENCH_PROBE_COUNT];
+    timer_t *timers = (timer_t *)calloc(pending, sizeof(timer_t));
+    int error = (timers == NULL) ? ENOMEM : 0;
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_NONE;
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+
+    uint64_t count = 0;
+    for (; (error == 0) && (count < pending); count++)
+    {
+        if (timer_create(CLOCK_MONOTONIC, &sev, &timers[count]) != 0)
+        {
+            error = errno;
+
+            break;
+        }
+        its.it_value = hs_timer_bench_ns_to_timespec(HS_TIMER_BENCH_IDLE_NS + (count % 4096) * HS_TIMER_BENCH_NSEC_PER_SEC);
+        timer_settime(timers[count], 0, &its, NULL);
+    }
+
+    // 测量定时器使用 SIGEV_THREAD，与原来每个 hs_timer_t 一个 POSIX 定时器的实现一致
+    uint32_t probe_count = 0;
+    __atomic_store_n(&s_posix_sample_count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_posix_probe_stop, false, __ATOMIC_RELAXED);
+    uint64_t start_ns = hs_timer_bench_now_ns();
+    for (; (error == 0) && (probe_count < HS_TIMER_BENCH_PROBE_COUNT); probe_count++)
+    {
+        hs_timer_bench_posix_probe_t *probe = &probes[probe_count];
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_THREAD;
+        sev.sigev_notify_function = hs_timer_bench_posix_probe_cb;
+        sev.sigev_value.sival_ptr = probe;
+        if (timer_create(CLOCK_MONOTONIC, &sev, &probe->timer) != 0)
+        {
+            error = errno;
+
+            break;
+        }
+
+        probe->deadline_ns = start_ns + HS_TIMER_BENCH_PROBE_NS;
+        its.it_value = hs_timer_bench_ns_to_timespec(probe->deadline_ns);
+        timer_settime(probe->timer, TIMER_ABSTIME, &its, NULL);
+    }
+
+    if (error == 0)
+    {
+        struct timespec ts = hs_timer_bench_ns_to_timespec(config->run_ns);
+        nanosleep(&ts, NULL);
+    }
+    __atomic_store_n(&s_posix_probe_stop, true, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < probe_count; i++)
+    {
+        timer_delete(probes[i].timer);
+    }
+    // 等待已经开始执行的回调结束
+    usleep((useconds_t)(HS_TIMER_BENCH_PROBE_NS / 1000) * 2);
+
+    hs_timer_bench_result_begin(output, "lateness", E_HS_TIMER_BENCH_BACKEND_POSIX);
+    printf(", \"pending\": %llu", (unsigned long long)pending);
+    uint32_t samples = __atomic_load_n(&s_posix_sample_count, __ATOMIC_RELAXED);
+    if (samples > HS_TIMER_BENCH_MAX_SAMPLES)
+    {
+        samples = HS_TIMER_BENCH_MAX_SAMPLES;
+    }
+    if ((error == 0) && (samples > 0))
+    {
+        qsort(s_posix_samples, samples, sizeof(uint64_t), hs_timer_bench_compare_u64);
+        printf(", \"samples\": %u, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu", samples,
+               (unsigned long long)s_posix_samples[(uint64_t)samples * 500 / 1000],
+               (unsigned long long)s_posix_samples[(uint64_t)samples * 990 / 1000],
+               (unsigned long long)s_posix_samples[(uint64_t)samples * 999 / 1000],
+               (unsigned long long)s_posix_samples[samples - 1]);
+    }
+    hs_timer_bench_result_end(error);
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        timer_delete(timers[i]);
+    }
+    free(timers);
+}
+
+/**
+ * @brief 记录一次周期回调的漂移
+ *
+ * @param[in,out] drift  : 周期漂移测量
+ * @param[in]     overrun: 本次回调之前跳过的周期数
+ */
+static void hs_timer_bench_drift_record(hs_timer_bench_drift_t *drift, const uint64_t overrun)
+{
+    uint64_t now_ns = hs_timer_bench_now_ns();
+
+    drift->fired++;
+    drift->periods += 1 + overrun;
+    drift->last_ns = now_ns;
+
+    int64_t delta = (int64_t)(now_ns - (drift->start_ns + drift->periods * drift->period_ns));
+    if (delta > drift->max_drift_ns)
+    {
+        drift->max_drift_ns = delta;
+    }
+}
+
+/**
+ * @brief 时间轮周期定时器回调
+ *
+ * @param[in] hs_timer: 定时器对象
+ */
+static void hs_timer_bench_drift_wheel_cb(hs_timer_t *hs_timer)
+{
+    hs_timer_bench_drift_t *drift = (hs_timer_bench_drift_t *)hs_timer_get_user_data(hs_timer);
+    uint32_t overrun = 0;
+    hs_timer_get_overrun(hs_timer, &overrun);
+
+    hs_timer_bench_drift_record(drift, overrun);
+}
+
+/**
+ * @brief POSIX 周期定时器回调
+ *
+ * @param[in] value: POSIX 间隔定时器的周期漂移测量
+ */
+static void hs_timer_bench_drift_posix_cb(union sigval value)
+{
+    hs_timer_bench_posix_drift_t *posix_drift = (hs_timer_bench_posix_drift_t *)value.sival_ptr;
+    int overrun = timer_getoverrun(posix_drift->timer);
+
+    hs_timer_bench_drift_record(&posix_drift->drift, (overrun > 0) ? (uint64_t)overrun : 0);
+}
+
+/**
+ * @brief 输出周期漂移结果
+ *
+ * @param[in,out] output : JSON 输出状态
+ * @param[in]     backend: 实现
+ * @param[in]     mode   : 周期模式名称
+ * @param[in]     drift  : 周期漂移测量
+ * @param[in]     error  : 错误码
+ */
+static void hs_timer_bench_drift_print(hs_timer_bench_output_t *output, const hs_timer_bench_backend_e backend,
+                                       const char *mode, const hs_timer_bench_drift_t *drift, const int error)
+{
+    hs_timer_bench_result_begin(output, "periodic_drift", backend);
+    printf(", \"mode\": \"%s\", \"period_ns\": %llu", mode, (unsigned long long)drift->period_ns);
+    if (error == 0)
+    {
+        // 最后一次回调相对理想周期时间的偏差即为累积漂移
+        int64_t final_ns = (int64_t)(drift->last_ns - (drift->start_ns + drift->periods * drift->period_ns));
+        printf(", \"fired\": %llu, \"periods\": %llu, \"final_drift_ns\": %lld, \"max_drift_ns\": %lld",
+               (unsigned long long)drift->fired, (unsigned long long)drift->periods,
+               (drift->fired != 0) ? (long long)final_ns : 0LL, (long long)drift->max_drift_ns);
+    }
+    hs_timer_bench_result_end(error);
+}
+
+/**
+ * @brief 周期定时器长时间运行的漂移
+ *
+ * @note 同时运行时间轮的相对/绝对周期定时器和 POSIX 间隔定时器
+ *
+ * @param[in,out] output: JSON 输出状态
+ * @param[in]     config: 测试配置
+ */
+static void hs_timer_bench_drift(hs_timer_bench_output_t *output, const hs_timer_bench_config_t *config)
+{
+    static const hs_timer_periodic_mode_e modes[] = {E_HS_TIMER_PERIODIC_RELATIVE, E_HS_TIMER_PERIODIC_SKIP};
+    static const char *mode_names[] = {"relative", "skip"};
+    static hs_timer_bench_drift_t drifts[2];
+    static hs_timer_bench_posix_drift_t posix_drift;
+
+    hs_timer_t *timers[2] = {NULL, NULL};
+    int errors[2] = {0, 0};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        memset(&drifts[i], 0, sizeof(hs_timer_bench_drift_t));
+        drifts[i].period_ns = config->drift_period_ns;
+        drifts[i].start_ns = hs_timer_bench_now_ns();
+        timers[i] = hs_timer_create();
+        if ((timers[i] == NULL) || (hs_timer_set_periodic_mode(timers[i], modes[i]) != 0) ||
+            (hs_timer_init_ns(timers[i], hs_timer_bench_drift_wheel_cb, HS_TIMER_REPEAT_FOREVER,
+                              config->drift_period_ns, &drifts[i]) != 0))
+        {
+            errors[i] = ENOMEM;
+        }
+    }
+
+    memset(&posix_drift, 0, sizeof(posix_drift));
+    posix_drift.drift.period_ns = config->drift_period_ns;
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD;
+    sev.sigev_notify_function = hs_timer_bench_drift_posix_cb;
+    sev.sigev_value.sival_ptr = &posix_drift;
+    int posix_error = 0;
+    if (timer_create(CLOCK_MONOTONIC, &sev, &posix_drift.timer) != 0)
+    {
+        posix_error = errno;
+    }
+    else
+    {
+        struct itimerspec its;
+        its.it_value = hs_timer_bench_ns_to_timespec(config->drift_period_ns);
+        its.it_interval = its.it_value;
+        posix_drift.drift.start_ns = hs_timer_bench_now_ns();
+        timer_settime(posix_drift.timer, 0, &its, NULL);
+    }
+
+    struct timespec ts = hs_timer_bench_ns_to_timespec(config->drift_ns);
+    nanosleep(&ts, NULL);
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (timers[i] != NULL)
+        {
+            hs_timer_pause(timers[i]);
+        }
+    }
+    if (posix_error == 0)
+    {
+        timer_delete(posix_drift.timer);
+    }
+    // 等待已经开始执行的回调结束
+    usleep((useconds_t)(config->drift_period_ns / 1000) * 2);
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        hs_timer_bench_drift_print(output, E_HS_TIMER_BENCH_BACKEND_WHEEL, mode_names[i], &drifts[i], errors[i]);
+        hs_timer_destroy(timers[i]);
+    }
+    hs_timer_bench_drift_print(output, E_HS_TIMER_BENCH_BACKEND_POSIX, "interval", &posix_drift.drift, posix_error);
+}
+
+/**
+ * @brief 输出使用说明
+ *
+ * @param[in] name: 程序名
+ */
+static void hs_timer_bench_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --quick                 smaller timer counts and shorter runs\n"
+            "  --scenario NAME         create_destroy | arm_cancel | lateness | periodic_drift\n"
+            "  --threads N             maximum threads for arm_cancel (1 ~ %u, default 64)\n"
+            "  --run-ms N              duration of each throughput/lateness run (default 1000)\n"
+            "  --drift-seconds N       duration of periodic_drift (default 10, 3600 for the 1 hour run)\n"
+            "  --drift-period-ms N     period of periodic_drift (default 10)\n",
+            name, HS_TIMER_BENCH_MAX_THREADS);
+}
+
+int main(int argc, char *argv[])
+{
+    hs_timer_bench_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_threads = HS_TIMER_BENCH_MAX_THREADS;
+    config.run_ns = 1000ULL * HS_TIMER_BENCH_NSEC_PER_MSEC;
+    config.drift_ns = 10ULL * HS_TIMER_BENCH_NSEC_PER_SEC;
+    config.drift_period_ns = 10ULL * HS_TIMER_BENCH_NSEC_PER_MSEC;
+    config.create_count = 1000000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            config.quick = true;
+            config.run_ns = 200ULL * HS_TIMER_BENCH_NSEC_PER_MSEC;
+            config.drift_ns = 2ULL * HS_TIMER_BENCH_NSEC_PER_SEC;
+            config.create_count = 100000;
+            continue;
+        }
+        if (value == NULL)
+        {
+            hs_timer_bench_usage(argv[0]);
+
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--scenario") == 0)
+        {
+            config.scenario = value;
+        }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            config.max_threads = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--run-ms") == 0)
+        {
+            config.run_ns = strtoull(value, NULL, 10) * HS_TIMER_BENCH_NSEC_PER_MSEC;
+        }
+        else if (strcmp(argv[i], "--drift-seconds") == 0)
+        {
+            config.drift_ns = strtoull(value, NULL, 10) * HS_TIMER_BENCH_NSEC_PER_SEC;
+        }
+        else if (strcmp(argv[i], "--drift-period-ms") == 0)
+        {
+            config.drift_period_ns = strtoull(value, NULL, 10) * HS_TIMER_BENCH_NSEC_PER_MSEC;
+        }
+        else
+        {
+            hs_timer_bench_usage(argv[0]);
+
+            return 1;
+        }
+        i++;
+    }
+    if ((config.max_threads == 0) || (config.max_threads > HS_TIMER_BENCH_MAX_THREADS) ||
+        (config.drift_period_ns == 0))
+    {
+        hs_timer_bench_usage(argv[0]);
+
+        return 1;
+    }
+
+    hs_timer_bench_output_t output = {0};
+    printf("{\n  \"benchmark\": \"hs_timer\",\n  \"config\": {\"quick\": %s, \"run_ns\": %llu, \"drift_ns\": %llu, "
+           "\"max_threads\": %u},\n  \"results\": [",
+           config.quick ? "true" : "false", (unsigned long long)config.run_ns, (unsigned long long)config.drift_ns,
+           config.max_threads);
+
+    if (hs_timer_bench_enabled(&config, "create_destroy"))
+    {
+        hs_timer_bench_create_destroy(&output, &config);
+    }
+
+    if (hs_timer_bench_enabled(&config, "arm_cancel"))
+    {
+        hs_timer_bench_churn(&output, &config);
+    }
+
+    if (hs_timer_bench_enabled(&config, "lateness"))
+    {
+        static const uint64_t pending_full[] = {1000, 100000, 1000000};
+        static const uint64_t pending_quick[] = {1000, 10000, 100000};
+        const uint64_t *pending = config.quick ? pending_quick : pending_full;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            hs_timer_bench_lateness_wheel(&output, &config, pending[i]);
+            hs_timer_bench_lateness_posix(&output, &config, pending[i]);
+        }
+    }
+
+    if (hs_timer_bench_enabled(&config, "periodic_drift"))
+    {
+        hs_timer_bench_drift(&output, &config);
+    }
+
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
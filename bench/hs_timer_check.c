@@ -0,0 +1,607 @@
+/**
+ * @file      hs_timer_check.c
+ * @brief     定时器引擎的自检程序 (派发预算、分组、堆后端等确定性场景)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-15 10:12:26
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hs_timer.h"
+
+#define HS_TIMER_CHECK_NSEC_PER_MSEC (1000000ULL) // 每毫秒的纳秒数
+#define HS_TIMER_CHECK_TICK_NS       (HS_TIMER_CHECK_NSEC_PER_MSEC) // 自检引擎的节拍时长 (单位: ns)
+#define HS_TIMER_CHECK_MAX_TASKS     (64U)        // 执行器最多暂存的任务数
+#define HS_TIMER_CHECK_ALIGN_TICKS   (64U)        // 延后容忍度对齐的节拍数
+#define HS_TIMER_CHECK_FINE_TICK_NS  (10000ULL)   // 长超时自检的节拍时长 (单位: ns; 混合模式约 41ms 以上放入堆)
+#define HS_TIMER_CHECK_MAX_ORDER     (16U)        // 最多记录的回调顺序
+#define HS_TIMER_CHECK_MAX_ROUNDS    (200U)       // 等待定时器到期时最多处理的次数
+
+// 暂存任务、由自检流程决定何时执行的执行器
+typedef struct hs_timer_check_executor
+{
+    hs_timer_task_fn task[HS_TIMER_CHECK_MAX_TASKS]; // 任务函数
+    void *arg[HS_TIMER_CHECK_MAX_TASKS];             // 任务参数
+    uint32_t count;                                  // 暂存的任务数
+} hs_timer_check_executor_t;
+
+// 回调顺序记录
+typedef struct hs_timer_check_order
+{
+    uint32_t id[HS_TIMER_CHECK_MAX_ORDER]; // 按回调先后记录的定时器编号
+    uint32_t count;                        // 已记录的回调数
+} hs_timer_check_order_t;
+
+// 记录回调顺序的定时器
+typedef struct hs_timer_check_entry
+{
+    hs_timer_check_order_t *order; // 回调顺序记录
+    uint32_t id;                   // 定时器编号
+} hs_timer_check_entry_t;
+
+// 批量回调记录
+typedef struct hs_timer_check_batch
+{
+    uint32_t calls;  // 批量回调次数
+    uint32_t timers; // 批量回调收到的定时器总数
+    size_t largest;  // 单次批量回调收到的最多定时器数
+} hs_timer_check_batch_t;
+
+// 自检项
+typedef struct hs_timer_check_case
+{
+    const char *name;                                     // 名称
+    bool (*run)(const hs_timer_engine_backend_e backend); // 自检函数
+} hs_timer_check_case_t;
+
+// 后端名称
+static const char *const s_backend_names[] = {
+    "wheel",
+    "heap",
+    "hybrid",
+};
+
+/**
+ * @brief 睡眠指定时间
+ *
+ * @param[in] ns: 睡眠时间 (单位: ns)
+ */
+static void hs_timer_check_sleep_ns(const uint64_t ns)
+{
+    struct timespec ts = {
+        .tv_sec = (time_t)(ns / (1000ULL * HS_TIMER_CHECK_NSEC_PER_MSEC)),
+        .tv_nsec = (long)(ns % (1000ULL * HS_TIMER_CHECK_NSEC_PER_MSEC)),
+    };
+    while (nanosleep(&ts, &ts) != 0)
+    {
+    }
+}
+
+/**
+ * @brief 执行器提交函数: 暂存任务
+ *
+ * @param[in]     task        : 任务函数
+ * @param[in,out] arg         : 任务参数
+ * @param[in,out] executor_ctx: 执行器
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (暂存已满，引擎在派发方直接执行)
+ */
+static int hs_timer_check_submit(hs_timer_task_fn task, void *arg, void *executor_ctx)
+{
+    hs_timer_check_executor_t *executor = (hs_timer_check_executor_t *)executor_ctx;
+    if (executor->count >= HS_TIMER_CHECK_MAX_TASKS)
+    {
+        return -1;
+    }
+
+    executor->task[executor->count] = task;
+    executor->arg[executor->count] = arg;
+    executor->count++;
+
+    return 0;
+}
+
+/**
+ * @brief 执行暂存的全部任务
+ *
+ * @param[in,out] executor: 执行器
+ */
+static void hs_timer_check_run_tasks(hs_timer_check_executor_t *executor)
+{
+    while (executor->count != 0)
+    {
+        uint32_t count = executor->count;
+        executor->count = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            executor->task[i](executor->arg[i]);
+        }
+    }
+}
+
+/**
+ * @brief 定时器回调: 累加用户数据指向的计数
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_check_count_cb(hs_timer_t *hs_timer)
+{
+    uint32_t *count = (uint32_t *)hs_timer_get_user_data(hs_timer);
+    (*count)++;
+}
+
+/**
+ * @brief 定时器回调: 记录回调顺序
+ *
+ * @param[in,out] hs_timer: 定时器对象 (用户数据为 hs_timer_check_entry_t)
+ */
+static void hs_timer_check_order_cb(hs_timer_t *hs_timer)
+{
+    const hs_timer_check_entry_t *entry = (const hs_timer_check_entry_t *)hs_timer_get_user_data(hs_timer);
+    if (entry->order->count < HS_TIMER_CHECK_MAX_ORDER)
+    {
+        entry->order->id[entry->order->count] = entry->id;
+    }
+    entry->order->count++;
+}
+
+/**
+ * @brief 分组批量回调: 记录回调次数和定时器数量
+ *
+ * @param[in] expired: 本次到期的定时器
+ * @param[in] count  : 定时器数量
+ * @param[in] ctx    : 批量回调记录
+ */
+static void hs_timer_check_batch_cb(hs_timer_t **expired, size_t count, void *ctx)
+{
+    (void)expired;
+    hs_timer_check_batch_t *batch = (hs_timer_check_batch_t *)ctx;
+    batch->calls++;
+    batch->timers += (uint32_t)count;
+    if (count > batch->largest)
+    {
+        batch->largest = count;
+    }
+}
+
+/**
+ * @brief 创建由执行器执行回调的外部驱动引擎
+ *
+ * @param[in]     backend : 到期时间管理方式
+ * @param[in]     tick_ns : 节拍时长 (单位: ns)
+ * @param[in]     budget  : 每次唤醒最多派发的回调数 (0: 不限制)
+ * @param[in,out] executor: 执行器
+ *
+ * @return 成功: 定时器引擎
+ * @return 失败: NULL
+ */
+static hs_timer_engine_t *hs_timer_check_engine_create(const hs_timer_engine_backend_e backend, const uint64_t tick_ns,
+                                                       const uint32_t budget, hs_timer_check_executor_t *executor)
+{
+    hs_timer_engine_config_t config;
+    hs_timer_engine_config_init(&config);
+    config.mode = E_HS_TIMER_ENGINE_MODE_EXTERNAL;
+    config.tick_ns = tick_ns;
+    config.backend = backend;
+    config.executor_submit = hs_timer_check_submit;
+    config.executor_ctx = executor;
+    config.dispatch_budget = budget;
+
+    hs_timer_engine_t *engine = hs_timer_engine_create(&config);
+    if (engine == NULL)
+    {
+        fprintf(stderr, "hs_timer_check: hs_timer_engine_create() failed\n");
+    }
+
+    return engine;
+}
+
+/**
+ * @brief 处理到期的定时器并执行任务，直到回调数达到预期或超出处理次数
+ *
+ * @param[in,out] engine  : 定时器引擎
+ * @param[in,out] executor: 执行器
+ * @param[in]     count   : 回调数
+ * @param[in]     expected: 预期的回调数
+ * @param[in]     sleep_ns: 每次处理后的睡眠时间 (单位: ns)
+ */
+static void hs_timer_check_process_until(hs_timer_engine_t *engine, hs_timer_check_executor_t *executor,
+                                         const uint32_t *count, const uint32_t expected, const uint64_t sleep_ns)
+{
+    for (uint32_t i = 0; (i < HS_TIMER_CHECK_MAX_ROUNDS) && (*count < expected); i++)
+    {
+        hs_timer_engine_process_expired(engine);
+        hs_timer_check_run_tasks(executor);
+        if (*count < expected)
+        {
+            hs_timer_check_sleep_ns(sleep_ns);
+        }
+    }
+}
+
+/**
+ * @brief 处理到期的定时器、执行全部任务后销毁引擎
+ *
+ * @param[in,out] engine  : 定时器引擎 (其上的定时器已全部销毁)
+ * @param[in,out] executor: 执行器
+ *
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool hs_timer_check_engine_destroy(hs_timer_engine_t *engine, hs_timer_check_executor_t *executor)
+{
+    do
+    {
+        hs_timer_check_run_tasks(executor);
+        hs_timer_engine_process_expired(engine);
+    } while (executor->count != 0);
+
+    return (hs_timer_engine_destroy(engine) == 0);
+}
+
+/**
+ * @brief 检查按预算推迟派发的周期定时器重新启动后只执行一次
+ *
+ * @note 1. 两个定时器在同一轮到期，预算为 1 时较晚的 deferred 留在等待派发的链表中
+ *       2. deferred 设置延后容忍度后调用 hs_timer_ready()，重新加入的节点在到期时间之后的对齐节拍上；
+ *          派发时必须移除这个节点，否则到期处理期间定时器仍留在时间轮或堆中，对齐节拍到来时再次到期
+ *
+ * @param[in] backend: 到期时间管理方式
+ *
+ * @return true : 通过
+ * @return false: 失败
+ */
+static bool hs_timer_check_budget_rearm(const hs_timer_engine_backend_e backend)
+{
+    hs_timer_check_executor_t executor;
+    memset(&executor, 0, sizeof(executor));
+    hs_timer_engine_t *engine = hs_timer_check_engine_create(backend, HS_TIMER_CHECK_TICK_NS, 1, &executor);
+    if (engine == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t first_count = 0;
+    uint32_t deferred_count = 0;
+    hs_timer_t *first = hs_timer_create_on(engine);
+    hs_timer_t *deferred = hs_timer_create_on(engine);
+    if ((first == NULL) || (deferred == NULL) ||
+        (hs_timer_init_ns(first, hs_timer_check_count_cb, HS_TIMER_REPEAT_ONCE, 4 * HS_TIMER_CHECK_NSEC_PER_MSEC,
+                          &first_count) != 0) ||
+        (hs_timer_init_ns(deferred, hs_timer_check_count_cb, HS_TIMER_REPEAT_FOREVER,
+                          5 * HS_TIMER_CHECK_NSEC_PER_MSEC, &deferred_count) != 0))
+    {
+        fprintf(stderr, "hs_timer_check: failed to create timers\n");
+
+        return false;
+    }
+
+    // 两个定时器都已到期，只派发较早的 first
+    hs_timer_check_sleep_ns(10 * HS_TIMER_CHECK_NSEC_PER_MSEC);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_check_run_tasks(&executor);
+    if ((first_count != 1) || (deferred_count != 0))
+    {
+        fprintf(stderr, "hs_timer_check: budget dispatched %u/%u callbacks, expected 1/0\n", first_count,
+                deferred_count);
+        ok = false;
+    }
+
+    // 在对齐节拍之后一个节拍重新启动，延后容忍度的窗口内低位 0 最多的节拍在约 30 个节拍之后
+    while (((hs_timer_engine_now_ns(engine) / HS_TIMER_CHECK_TICK_NS) % HS_TIMER_CHECK_ALIGN_TICKS) != 1)
+    {
+        hs_timer_check_sleep_ns(HS_TIMER_CHECK_TICK_NS / 4);
+    }
+    hs_timer_set_slack_ns(deferred, (HS_TIMER_CHECK_ALIGN_TICKS - 4) * HS_TIMER_CHECK_TICK_NS);
+    hs_timer_ready(deferred);
+
+    // 到期时间已过，从等待派发的链表中派发；执行器暂不执行，定时器不应再留在时间轮或堆中
+    hs_timer_check_sleep_ns(3 * HS_TIMER_CHECK_TICK_NS);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_engine_stats_t stats;
+    hs_timer_engine_get_stats(engine, &stats);
+    if ((executor.count != 1) || (stats.active_count != 0))
+    {
+        fprintf(stderr, "hs_timer_check: re-armed deferred timer submitted %u tasks, %llu queued, expected 1/0\n",
+                executor.count, (unsigned long long)stats.active_count);
+        ok = false;
+    }
+
+    // 越过对齐节拍后结束到期处理，周期重启的到期时间还没到，不应再派发
+    hs_timer_check_sleep_ns((HS_TIMER_CHECK_ALIGN_TICKS / 2 + 8) * HS_TIMER_CHECK_TICK_NS);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_check_run_tasks(&executor);
+    hs_timer_engine_process_expired(engine);
+    if ((deferred_count != 1) || (executor.count != 0))
+    {
+        fprintf(stderr, "hs_timer_check: re-armed deferred timer ran %u times with %u tasks queued, expected 1/0\n",
+                deferred_count, executor.count);
+        ok = false;
+    }
+
+    hs_timer_destroy(deferred);
+    if (!hs_timer_check_engine_destroy(engine, &executor))
+    {
+        fprintf(stderr, "hs_timer_check: hs_timer_engine_destroy() failed\n");
+        ok = false;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief 检查派发预算下分组成员与普通定时器按引擎时间的先后派发
+ *
+ * @note 分组推迟后成员的到期时间 (分组时钟) 小于普通定时器，换算为引擎时间后却更晚；
+ *       所有定时器同一轮到期，预算为 1 时每次处理只派发最早的一个
+ *
+ * @param[in] backend: 到期时间管理方式
+ *
+ * @return true : 通过
+ * @return false: 失败
+ */
+static bool hs_timer_check_budget_order(const hs_timer_engine_backend_e backend)
+{
+    // 普通定时器与分组成员 (分组推迟 20ms) 的超时时间 (单位: ms)，按引擎时间的先后为 0 ~ 6
+    static const uint32_t timeouts_ms[] = {5, 15, 1, 24, 8, 32, 16};
+    static const bool in_group[] = {false, false, true, false, true, false, true};
+    const uint32_t total = sizeof(timeouts_ms) / sizeof(timeouts_ms[0]);
+
+    hs_timer_check_executor_t executor;
+    memset(&executor, 0, sizeof(executor));
+    hs_timer_engine_t *engine = hs_timer_check_engine_create(backend, HS_TIMER_CHECK_TICK_NS, 1, &executor);
+    if (engine == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    hs_timer_check_order_t order;
+    memset(&order, 0, sizeof(order));
+    hs_timer_check_entry_t entries[sizeof(timeouts_ms) / sizeof(timeouts_ms[0])];
+    hs_timer_group_t *group = hs_timer_group_create(engine, NULL, NULL);
+    if ((group == NULL) || (hs_timer_group_postpone_ns(group, 20 * HS_TIMER_CHECK_NSEC_PER_MSEC) != 0))
+    {
+        fprintf(stderr, "hs_timer_check: failed to create group\n");
+
+        return false;
+    }
+
+    for (uint32_t i = 0; i < total; i++)
+    {
+        entries[i].order = &order;
+        entries[i].id = i;
+        hs_timer_t *hs_timer = in_group[i] ? hs_timer_create_in_group(group) : hs_timer_create_on(engine);
+        if ((hs_timer == NULL) ||
+            (hs_timer_init_ns(hs_timer, hs_timer_check_order_cb, HS_TIMER_REPEAT_ONCE,
+                              timeouts_ms[i] * HS_TIMER_CHECK_NSEC_PER_MSEC, &entries[i]) != 0))
+        {
+            fprintf(stderr, "hs_timer_check: failed to create timers\n");
+
+            return false;
+        }
+    }
+
+    // 全部到期后逐次处理
+    hs_timer_check_sleep_ns(45 * HS_TIMER_CHECK_NSEC_PER_MSEC);
+    hs_timer_check_process_until(engine, &executor, &order.count, total, HS_TIMER_CHECK_TICK_NS);
+    if (order.count != total)
+    {
+        fprintf(stderr, "hs_timer_check: %u of %u timers fired\n", order.count, total);
+        ok = false;
+    }
+    for (uint32_t i = 0; (i < order.count) && (i < total); i++)
+    {
+        if (order.id[i] != i)
+        {
+            fprintf(stderr, "hs_timer_check: dispatch #%u was timer %u, expected %u\n", i, order.id[i], i);
+            ok = false;
+        }
+    }
+
+    hs_timer_group_destroy(group);
+    if (!hs_timer_check_engine_destroy(engine, &executor))
+    {
+        fprintf(stderr, "hs_timer_check: hs_timer_engine_destroy() failed\n");
+        ok = false;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief 检查分组的批量回调和分组时钟的暂停、恢复
+ *
+ * @note 1. 同一轮到期的成员只调用一次批量回调
+ *       2. 分组暂停期间成员不到期，恢复后保持暂停时的剩余时间
+ *
+ * @param[in] backend: 到期时间管理方式
+ *
+ * @return true : 通过
+ * @return false: 失败
+ */
+static bool hs_timer_check_group_batch(const hs_timer_engine_backend_e backend)
+{
+    hs_timer_check_executor_t executor;
+    memset(&executor, 0, sizeof(executor));
+    hs_timer_engine_t *engine = hs_timer_check_engine_create(backend, HS_TIMER_CHECK_TICK_NS, 0, &executor);
+    if (engine == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    hs_timer_check_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    hs_timer_group_t *group = hs_timer_group_create(engine, hs_timer_check_batch_cb, &batch);
+    if (group == NULL)
+    {
+        fprintf(stderr, "hs_timer_check: failed to create group\n");
+
+        return false;
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        hs_timer_t *hs_timer = hs_timer_create_in_group(group);
+        if ((hs_timer == NULL) ||
+            (hs_timer_init_ns(hs_timer, NULL, HS_TIMER_REPEAT_ONCE, 5 * HS_TIMER_CHECK_NSEC_PER_MSEC, NULL) != 0))
+        {
+            fprintf(stderr, "hs_timer_check: failed to create timers\n");
+
+            return false;
+        }
+    }
+
+    // 三个成员在同一轮到期
+    hs_timer_check_sleep_ns(10 * HS_TIMER_CHECK_NSEC_PER_MSEC);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_check_run_tasks(&executor);
+    if ((batch.calls != 1) || (batch.timers != 3))
+    {
+        fprintf(stderr, "hs_timer_check: batch callback ran %u times for %u timers, expected 1/3\n", batch.calls,
+                batch.timers);
+        ok = false;
+    }
+
+    // 剩余 20ms 时暂停 30ms，恢复后仍需约 20ms 才到期
+    hs_timer_t *paused = hs_timer_create_in_group(group);
+    if ((paused == NULL) ||
+        (hs_timer_init_ns(paused, NULL, HS_TIMER_REPEAT_ONCE, 20 * HS_TIMER_CHECK_NSEC_PER_MSEC, NULL) != 0))
+    {
+        fprintf(stderr, "hs_timer_check: failed to create timers\n");
+
+        return false;
+    }
+    hs_timer_group_pause(group);
+    hs_timer_check_sleep_ns(30 * HS_TIMER_CHECK_NSEC_PER_MSEC);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_check_run_tasks(&executor);
+    hs_timer_group_resume(group);
+    hs_timer_check_sleep_ns(5 * HS_TIMER_CHECK_NSEC_PER_MSEC);
+    hs_timer_engine_process_expired(engine);
+    hs_timer_check_run_tasks(&executor);
+    if (batch.timers != 3)
+    {
+        fprintf(stderr, "hs_timer_check: member of a paused group fired early\n");
+        ok = false;
+    }
+
+    hs_timer_check_process_until(engine, &executor, &batch.timers, 4, HS_TIMER_CHECK_TICK_NS);
+    if ((batch.calls != 2) || (batch.timers != 4))
+    {
+        fprintf(stderr, "hs_timer_check: resumed member fired %u times, expected 1\n", batch.timers - 3);
+        ok = false;
+    }
+
+    hs_timer_group_destroy(group);
+    if (!hs_timer_check_engine_destroy(engine, &executor))
+    {
+        fprintf(stderr, "hs_timer_check: hs_timer_engine_destroy() failed\n");
+        ok = false;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief 检查长超时定时器按时到期、暂停后不再到期
+ *
+ * @note 节拍为 10us，混合模式下 60ms 的超时放入堆，堆模式下全部定时器都在堆中
+ *
+ * @param[in] backend: 到期时间管理方式
+ *
+ * @return true : 通过
+ * @return false: 失败
+ */
+static bool hs_timer_check_long_horizon(const hs_timer_engine_backend_e backend)
+{
+    hs_timer_check_executor_t executor;
+    memset(&executor, 0, sizeof(executor));
+    hs_timer_engine_t *engine = hs_timer_check_engine_create(backend, HS_TIMER_CHECK_FINE_TICK_NS, 0, &executor);
+    if (engine == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t short_count = 0;
+    uint32_t long_count = 0;
+    uint32_t paused_count = 0;
+    uint64_t start_ns = hs_timer_engine_now_ns(engine);
+    hs_timer_t *short_timer = hs_timer_create_on(engine);
+    hs_timer_t *long_timer = hs_timer_create_on(engine);
+    hs_timer_t *paused = hs_timer_create_on(engine);
+    if ((short_timer == NULL) || (long_timer == NULL) || (paused == NULL) ||
+        (hs_timer_init_ns(short_timer, hs_timer_check_count_cb, HS_TIMER_REPEAT_ONCE,
+                          5 * HS_TIMER_CHECK_NSEC_PER_MSEC, &short_count) != 0) ||
+        (hs_timer_init_ns(long_timer, hs_timer_check_count_cb, HS_TIMER_REPEAT_ONCE,
+                          60 * HS_TIMER_CHECK_NSEC_PER_MSEC, &long_count) != 0) ||
+        (hs_timer_init_ns(paused, hs_timer_check_count_cb, HS_TIMER_REPEAT_ONCE, 50 * HS_TIMER_CHECK_NSEC_PER_MSEC,
+                          &paused_count) != 0) ||
+        (hs_timer_pause(paused) != 0))
+    {
+        fprintf(stderr, "hs_timer_check: failed to create timers\n");
+
+        return false;
+    }
+
+    hs_timer_check_process_until(engine, &executor, &long_count, 1, HS_TIMER_CHECK_NSEC_PER_MSEC);
+    uint64_t elapsed_ns = hs_timer_engine_now_ns(engine) - start_ns;
+    if ((short_count != 1) || (long_count != 1) || (paused_count != 0) ||
+        (elapsed_ns < (60 * HS_TIMER_CHECK_NSEC_PER_MSEC)))
+    {
+        fprintf(stderr, "hs_timer_check: short/long/paused fired %u/%u/%u after %llu ns, expected 1/1/0 after 60ms\n",
+                short_count, long_count, paused_count, (unsigned long long)elapsed_ns);
+        ok = false;
+    }
+
+    hs_timer_destroy(paused);
+    if (!hs_timer_check_engine_destroy(engine, &executor))
+    {
+        fprintf(stderr, "hs_timer_check: hs_timer_engine_destroy() failed\n");
+        ok = false;
+    }
+
+    return ok;
+}
+
+int main(void)
+{
+    static const hs_timer_engine_backend_e backends[] = {
+        E_HS_TIMER_ENGINE_BACKEND_WHEEL,
+        E_HS_TIMER_ENGINE_BACKEND_HEAP,
+        E_HS_TIMER_ENGINE_BACKEND_HYBRID,
+    };
+    static const hs_timer_check_case_t cases[] = {
+        {"budget_rearm", hs_timer_check_budget_rearm},
+        {"budget_order", hs_timer_check_budget_order},
+        {"group_batch", hs_timer_check_group_batch},
+        {"long_horizon", hs_timer_check_long_horizon},
+    };
+
+    uint32_t failed = 0;
+    for (size_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        for (size_t j = 0; j < (sizeof(backends) / sizeof(backends[0])); j++)
+        {
+            bool ok = cases[i].run(backends[j]);
+            printf("%-12s %-6s %s\n", cases[i].name, s_backend_names[backends[j]], ok ? "ok" : "FAILED");
+            failed += ok ? 0 : 1;
+        }
+    }
+
+    return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,706 @@
+/**
+ * @file      hs_timer_stress.c
+ * @brief     定时器并发压力测试程序
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 21:05:37
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "hs_timer.h"
+
+#define HS_TIMER_STRESS_NSEC_PER_SEC  (1000000000ULL) // 每秒的纳秒数
+#define HS_TIMER_STRESS_NSEC_PER_MSEC (1000000ULL)    // 每毫秒的纳秒数
+#define HS_TIMER_STRESS_NSEC_PER_USEC (1000ULL)       // 每微秒的纳秒数
+#define HS_TIMER_STRESS_MAX_THREADS   (256U)          // 最大线程数
+#define HS_TIMER_STRESS_MAGIC         (0x48535453U)   // 存活票据的校验值
+#define HS_TIMER_STRESS_DEAD          (0xDEADDEADU)   // 已释放票据的校验值
+#define HS_TIMER_STRESS_MAX_REPORTS   (16U)           // 最多输出的错误信息数量
+#define HS_TIMER_STRESS_DRAIN_NS      (10ULL * HS_TIMER_STRESS_NSEC_PER_SEC) // 等待引擎回收的最长时间 (单位: ns)
+#define HS_TIMER_STRESS_MAX_REPEAT    (4U)            // 有限重复次数的上限
+#define HS_TIMER_STRESS_SHORT_NS      (50ULL * HS_TIMER_STRESS_NSEC_PER_USEC) // 竞争最后一次到期时的超时上限 (单位: ns)
+
+// 压力测试的操作
+typedef enum hs_timer_stress_op
+{
+    E_HS_TIMER_STRESS_OP_INIT = 0,     // hs_timer_init_ns() 重新初始化
+    E_HS_TIMER_STRESS_OP_READY,        // hs_timer_ready()
+    E_HS_TIMER_STRESS_OP_PAUSE,        // hs_timer_pause()
+    E_HS_TIMER_STRESS_OP_RESUME,       // hs_timer_resume()
+    E_HS_TIMER_STRESS_OP_CANCEL_LAZY,  // hs_timer_cancel_lazy()
+    E_HS_TIMER_STRESS_OP_POSTPONE,     // hs_timer_postpone_ns()
+    E_HS_TIMER_STRESS_OP_DESTROY,      // hs_timer_destroy() 后重新创建
+    E_HS_TIMER_STRESS_OP_DESTROY_SYNC, // hs_timer_destroy_sync() 后重新创建
+    E_HS_TIMER_STRESS_OP_EXPIRE_SYNC,  // 改为很快到期的单次定时器，在到期前后 hs_timer_destroy_sync() 后重新创建
+    E_HS_TIMER_STRESS_OP_CREATE,       // hs_timer_create_on() 或 hs_timer_init_static() + 初始化 (销毁后的重新创建)
+    E_HS_TIMER_STRESS_OP_MAX,
+} hs_timer_stress_op_e;
+
+// 测试配置
+typedef struct hs_timer_stress_config
+{
+    uint32_t threads;        // 操作线程数
+    uint32_t slots;          // 共享的定时器数量
+    uint32_t workers;        // 引擎回调工作线程数
+    uint64_t run_ns;         // 运行时间 (单位: ns)
+    uint64_t max_timeout_ns; // 随机超时时间的上限 (单位: ns)
+    uint64_t seed;           // 随机数种子
+} hs_timer_stress_config_t;
+
+typedef struct hs_timer_stress_slot hs_timer_stress_slot_t;
+
+// 定时器的存活票据 (作为用户数据，引擎回收定时器时释放)
+typedef struct hs_timer_stress_ticket
+{
+    uint32_t magic;               // 校验值 (释放前改写，回收后仍执行的回调可以被发现)
+    uint32_t in_callback;         // 正在执行的回调数量 (大于 1 表示同一定时器的回调并发)
+    uint64_t serial;              // 在所属槽位上的创建序号
+    hs_timer_stress_slot_t *slot; // 所属槽位
+} hs_timer_stress_ticket_t;
+
+// 共享定时器槽位
+struct hs_timer_stress_slot
+{
+    hs_timer_t *hs_timer;       // 当前的定时器 (NULL: 正在销毁重建)
+    uint32_t users;             // 正在使用当前定时器的线程数
+    uint64_t released;          // 槽位上已被引擎回收的最大定时器序号 (对象池上先销毁的定时器可能后回收)
+    uint64_t spawned;           // 槽位上最近创建的定时器序号 (只由重建槽位的线程访问)
+    bool on_storage;            // 当前定时器是否在 storage 上 (发布 hs_timer 前写入)
+    hs_timer_storage_t storage; // 槽位自己的存储空间 (回收后仍属于槽位，有限重复次数的定时器自动销毁后句柄不会被复用)
+} __attribute__((aligned(64)));
+
+// 操作线程参数
+typedef struct hs_timer_stress_worker
+{
+    const hs_timer_stress_config_t *config;  // 测试配置
+    hs_timer_engine_t *engine;               // 引擎
+    hs_timer_stress_slot_t *slots;           // 共享定时器槽位
+    const bool *start;                       // 开始标志
+    const bool *stop;                        // 结束标志
+    uint64_t rng;                            // 随机数状态
+    uint64_t ok[E_HS_TIMER_STRESS_OP_MAX];   // 成功的调用次数
+    uint64_t fail[E_HS_TIMER_STRESS_OP_MAX]; // 返回失败的调用次数 (状态不允许等，不算错误)
+    uint64_t ns[E_HS_TIMER_STRESS_OP_MAX];   // 调用耗时 (单位: ns)
+    pthread_t thread;                        // 线程
+} hs_timer_stress_worker_t;
+
+// 操作名称
+static const char *const s_op_names[E_HS_TIMER_STRESS_OP_MAX] = {
+    "init", "ready", "pause", "resume", "cancel_lazy", "postpone", "destroy", "destroy_sync", "expire_sync", "create",
+};
+
+// 随机选择操作的权重表 (销毁较少，其它操作在存活的定时器上并发进行)
+static const hs_timer_stress_op_e s_op_table[] = {
+    E_HS_TIMER_STRESS_OP_INIT,        E_HS_TIMER_STRESS_OP_INIT,        E_HS_TIMER_STRESS_OP_READY,
+    E_HS_TIMER_STRESS_OP_READY,       E_HS_TIMER_STRESS_OP_PAUSE,       E_HS_TIMER_STRESS_OP_PAUSE,
+    E_HS_TIMER_STRESS_OP_PAUSE,       E_HS_TIMER_STRESS_OP_RESUME,      E_HS_TIMER_STRESS_OP_RESUME,
+    E_HS_TIMER_STRESS_OP_RESUME,      E_HS_TIMER_STRESS_OP_CANCEL_LAZY, E_HS_TIMER_STRESS_OP_CANCEL_LAZY,
+    E_HS_TIMER_STRESS_OP_POSTPONE,    E_HS_TIMER_STRESS_OP_POSTPONE,    E_HS_TIMER_STRESS_OP_DESTROY,
+    E_HS_TIMER_STRESS_OP_DESTROY_SYNC, E_HS_TIMER_STRESS_OP_EXPIRE_SYNC,
+};
+
+static uint64_t s_created = 0;    // 创建的定时器数量
+static uint64_t s_released = 0;   // 引擎回收的定时器数量
+static uint64_t s_callbacks = 0;  // 回调次数
+static uint64_t s_violations = 0; // 发现的错误数量
+
+/**
+ * @brief 获取 CLOCK_MONOTONIC 当前时间
+ *
+ * @return 当前时间 (单位: ns)
+ */
+static uint64_t hs_timer_stress_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * HS_TIMER_STRESS_NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 生成下一个随机数 (xorshift64*)
+ *
+ * @param[in,out] rng: 随机数状态 (不能为 0)
+ *
+ * @return 随机数
+ */
+static uint64_t hs_timer_stress_next(uint64_t *rng)
+{
+    uint64_t x = *rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *rng = x;
+
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief 记录一次错误
+ *
+ * @param[in] what: 错误描述
+ */
+static void hs_timer_stress_violation(const char *what)
+{
+    uint64_t count = __atomic_add_fetch(&s_violations, 1, __ATOMIC_RELAXED);
+    if (count <= HS_TIMER_STRESS_MAX_REPORTS)
+    {
+        fprintf(stderr, "hs_timer_stress: %s\n", what);
+    }
+}
+
+/**
+ * @brief 定时器回调
+ *
+ * @note 检查票据仍然存活、同一定时器的回调没有并发；偶尔在回调中推迟自己
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_stress_cb(hs_timer_t *hs_timer)
+{
+    hs_timer_stress_ticket_t *ticket = (hs_timer_stress_ticket_t *)hs_timer_get_user_data(hs_timer);
+    if ((ticket == NULL) || (__atomic_load_n(&ticket->magic, __ATOMIC_RELAXED) != HS_TIMER_STRESS_MAGIC))
+    {
+        hs_timer_stress_violation("callback ran on a released timer");
+
+        return;
+    }
+
+    if (__atomic_add_fetch(&ticket->in_callback, 1, __ATOMIC_ACQ_REL) != 1)
+    {
+        hs_timer_stress_violation("callbacks of one timer ran concurrently");
+    }
+
+    uint64_t count = __atomic_add_fetch(&s_callbacks, 1, __ATOMIC_RELAXED);
+    if ((count % 8) == 0)
+    {
+        hs_timer_postpone_ns(hs_timer, (count % 1000) * HS_TIMER_STRESS_NSEC_PER_USEC);
+    }
+
+    __atomic_sub_fetch(&ticket->in_callback, 1, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief 定时器回收回调
+ *
+ * @note 释放票据，之后仍执行的回调会读到已释放的内存 (ASan 可以直接发现)
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_stress_release_cb(hs_timer_t *hs_timer)
+{
+    hs_timer_stress_ticket_t *ticket = (hs_timer_stress_ticket_t *)hs_timer_get_user_data(hs_timer);
+    if (ticket == NULL)
+    {
+        return;
+    }
+
+    if (__atomic_load_n(&ticket->in_callback, __ATOMIC_ACQUIRE) != 0)
+    {
+        hs_timer_stress_violation("timer released while its callback was running");
+    }
+    uint64_t released = __atomic_load_n(&ticket->slot->released, __ATOMIC_RELAXED);
+    while ((released < ticket->serial) &&
+           !__atomic_compare_exchange_n(&ticket->slot->released, &released, ticket->serial, true, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+    {
+    }
+    __atomic_add_fetch(&s_released, 1, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&ticket->magic, HS_TIMER_STRESS_DEAD, __ATOMIC_RELAXED);
+    free(ticket);
+}
+
+/**
+ * @brief 生成随机的超时时间
+ *
+ * @param[in]     config: 测试配置
+ * @param[in,out] rng   : 随机数状态
+ *
+ * @return 超时时间 (单位: ns; 不为 0，避免周期为 0 的定时器占满派发方)
+ */
+static uint64_t hs_timer_stress_timeout_ns(const hs_timer_stress_config_t *config, uint64_t *rng)
+{
+    return HS_TIMER_STRESS_NSEC_PER_USEC + (hs_timer_stress_next(rng) % config->max_timeout_ns);
+}
+
+/**
+ * @brief 生成随机的重复次数
+ *
+ * @note 有限重复次数的定时器会在最后一次回调后自动销毁，只用于槽位存储空间上的定时器 (句柄不会被其它槽位复用)
+ *
+ * @param[in]     on_storage: 定时器是否在槽位的存储空间上
+ * @param[in,out] rng       : 随机数状态
+ *
+ * @return 重复次数
+ */
+static uint32_t hs_timer_stress_repeat(const bool on_storage, uint64_t *rng)
+{
+    uint64_t r = hs_timer_stress_next(rng) % (2 * HS_TIMER_STRESS_MAX_REPEAT);
+    if (!on_storage || (r >= HS_TIMER_STRESS_MAX_REPEAT))
+    {
+        return HS_TIMER_REPEAT_FOREVER;
+    }
+
+    return (r == 0) ? HS_TIMER_REPEAT_ONCE : (uint32_t)r + 1;
+}
+
+/**
+ * @brief 槽位上当前的定时器是否已被引擎回收
+ *
+ * @param[in] slot: 槽位
+ *
+ * @return true : 是
+ * @return false: 否
+ */
+static bool hs_timer_stress_released(const hs_timer_stress_slot_t *slot)
+{
+    return (__atomic_load_n(&slot->released, __ATOMIC_ACQUIRE) >= slot->spawned);
+}
+
+/**
+ * @brief 在槽位上创建并启动一个新定时器
+ *
+ * @note 随机使用对象池或槽位的存储空间，存储空间上的定时器随机使用有限的重复次数
+ *
+ * @param[in,out] worker: 操作线程参数
+ * @param[in,out] slot  : 槽位
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL
+ */
+static hs_timer_t *hs_timer_stress_spawn(hs_timer_stress_worker_t *worker, hs_timer_stress_slot_t *slot)
+{
+    hs_timer_stress_ticket_t *ticket = (hs_timer_stress_ticket_t *)malloc(sizeof(hs_timer_stress_ticket_t));
+    if (ticket == NULL)
+    {
+        return NULL;
+    }
+    ticket->magic = HS_TIMER_STRESS_MAGIC;
+    ticket->in_callback = 0;
+    ticket->slot = slot;
+    ticket->serial = slot->spawned + 1;
+
+    uint64_t r = hs_timer_stress_next(&worker->rng);
+    bool on_storage = ((r % 2) == 0);
+    hs_timer_t *hs_timer = on_storage ? hs_timer_init_static(&slot->storage, worker->engine)
+                                      : hs_timer_create_on(worker->engine);
+    if (hs_timer == NULL)
+    {
+        free(ticket);
+
+        return NULL;
+    }
+    __atomic_add_fetch(&s_created, 1, __ATOMIC_RELAXED);
+    slot->spawned++;
+    __atomic_store_n(&slot->on_storage, on_storage, __ATOMIC_RELAXED);
+
+    // 先设置用户数据和回收回调，之后任何失败都由引擎回收时释放票据
+    hs_timer_set_user_data(hs_timer, ticket);
+    hs_timer_set_release_cb(hs_timer, hs_timer_stress_release_cb);
+    hs_timer_set_periodic_mode(hs_timer, (hs_timer_periodic_mode_e)((r >> 1) % 4));
+    hs_timer_set_priority(hs_timer, ((r >> 8) % 8 == 0) ? E_HS_TIMER_PRIORITY_HIGH : E_HS_TIMER_PRIORITY_NORMAL);
+    if (hs_timer_init_ns(hs_timer, hs_timer_stress_cb, hs_timer_stress_repeat(on_storage, &worker->rng),
+                         hs_timer_stress_timeout_ns(worker->config, &worker->rng), ticket) != 0)
+    {
+        hs_timer_stress_violation("hs_timer_init_ns() failed on a new timer");
+        hs_timer_destroy(hs_timer);
+
+        return NULL;
+    }
+
+    return hs_timer;
+}
+
+/**
+ * @brief 销毁槽位上的定时器，并创建新定时器替换
+ *
+ * @note 1. 先取下定时器，等待正在使用它的线程离开后再销毁，其它线程不会使用已销毁的定时器
+ *       2. 销毁与引擎中正在执行的回调并发，由回收回调检查回调结束后才回收
+ *       3. 存储空间上有限重复次数的定时器可能已自动销毁，此时 hs_timer_destroy() 返回失败不算错误
+ *       4. E_HS_TIMER_STRESS_OP_EXPIRE_SYNC 把存储空间上的定时器改为很快到期的单次定时器，在到期前后随机的时刻
+ *          同步销毁，与最后一次回调和自动销毁竞争
+ *
+ * @param[in,out] worker: 操作线程参数
+ * @param[in,out] slot  : 槽位
+ * @param[in]     op    : 操作 (E_HS_TIMER_STRESS_OP_DESTROY、DESTROY_SYNC 或 EXPIRE_SYNC)
+ */
+static void hs_timer_stress_replace(hs_timer_stress_worker_t *worker, hs_timer_stress_slot_t *slot,
+                                    const hs_timer_stress_op_e op)
+{
+    hs_timer_t *hs_timer = __atomic_exchange_n(&slot->hs_timer, NULL, __ATOMIC_SEQ_CST);
+    if (hs_timer == NULL)
+    {
+        // 其它线程正在重建该槽位
+        return;
+    }
+    while (__atomic_load_n(&slot->users, __ATOMIC_SEQ_CST) != 0)
+    {
+        sched_yield();
+    }
+
+    bool sync = (op != E_HS_TIMER_STRESS_OP_DESTROY);
+    bool on_storage = __atomic_load_n(&slot->on_storage, __ATOMIC_RELAXED);
+    uint64_t start_ns = hs_timer_stress_now_ns();
+    if ((op == E_HS_TIMER_STRESS_OP_EXPIRE_SYNC) && on_storage)
+    {
+        // 已自动销毁时重新初始化失败，直接同步销毁
+        uint64_t timeout_ns =
+            HS_TIMER_STRESS_NSEC_PER_USEC + (hs_timer_stress_next(&worker->rng) % HS_TIMER_STRESS_SHORT_NS);
+        uint64_t wait_ns = hs_timer_stress_next(&worker->rng) % (2 * timeout_ns);
+        hs_timer_init_ns(hs_timer, hs_timer_stress_cb, HS_TIMER_REPEAT_ONCE, timeout_ns,
+                         hs_timer_get_user_data(hs_timer));
+        start_ns = hs_timer_stress_now_ns();
+        while (hs_timer_stress_now_ns() - start_ns < wait_ns)
+        {
+        }
+        start_ns = hs_timer_stress_now_ns();
+    }
+    int ret = sync ? hs_timer_destroy_sync(hs_timer) : hs_timer_destroy(hs_timer);
+    worker->ns[op] += hs_timer_stress_now_ns() - start_ns;
+    if (ret == 0)
+    {
+        worker->ok[op]++;
+        if (sync && !hs_timer_stress_released(slot))
+        {
+            hs_timer_stress_violation("hs_timer_destroy_sync() returned before the timer was released");
+        }
+    }
+    else if (on_storage && hs_timer_stress_released(slot))
+    {
+        // 有限重复次数的定时器已自动销毁
+        worker->fail[op]++;
+    }
+    else
+    {
+        hs_timer_stress_violation("destroying a live timer failed");
+        worker->fail[op]++;
+    }
+
+    // 存储空间在定时器回收后才能复用
+    while (on_storage && !hs_timer_stress_released(slot))
+    {
+        sched_yield();
+    }
+
+    start_ns = hs_timer_stress_now_ns();
+    hs_timer = hs_timer_stress_spawn(worker, slot);
+    worker->ns[E_HS_TIMER_STRESS_OP_CREATE] += hs_timer_stress_now_ns() - start_ns;
+    if (hs_timer != NULL)
+    {
+        worker->ok[E_HS_TIMER_STRESS_OP_CREATE]++;
+    }
+    else
+    {
+        worker->fail[E_HS_TIMER_STRESS_OP_CREATE]++;
+    }
+    __atomic_store_n(&slot->hs_timer, hs_timer, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief 对存活的定时器执行一次操作
+ *
+ * @param[in,out] worker    : 操作线程参数
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     on_storage: 定时器是否在槽位的存储空间上 (是时可以改为有限的重复次数)
+ * @param[in]     op        : 操作
+ */
+static void hs_timer_stress_apply(hs_timer_stress_worker_t *worker, hs_timer_t *hs_timer, const bool on_storage,
+                                  const hs_timer_stress_op_e op)
+{
+    uint64_t timeout_ns = hs_timer_stress_timeout_ns(worker->config, &worker->rng);
+    uint64_t start_ns = hs_timer_stress_now_ns();
+    int ret = -1;
+    switch (op)
+    {
+    case E_HS_TIMER_STRESS_OP_INIT:
+        ret = hs_timer_init_ns(hs_timer, hs_timer_stress_cb, hs_timer_stress_repeat(on_storage, &worker->rng),
+                               timeout_ns, hs_timer_get_user_data(hs_timer));
+        break;
+
+    case E_HS_TIMER_STRESS_OP_READY:
+        ret = hs_timer_ready(hs_timer);
+        break;
+
+    case E_HS_TIMER_STRESS_OP_PAUSE:
+        ret = hs_timer_pause(hs_timer);
+        break;
+
+    case E_HS_TIMER_STRESS_OP_RESUME:
+        ret = hs_timer_resume(hs_timer);
+        break;
+
+    case E_HS_TIMER_STRESS_OP_CANCEL_LAZY:
+        ret = hs_timer_cancel_lazy(hs_timer);
+        break;
+
+    case E_HS_TIMER_STRESS_OP_POSTPONE:
+        ret = hs_timer_postpone_ns(hs_timer, timeout_ns);
+        break;
+
+    default:
+        break;
+    }
+    worker->ns[op] += hs_timer_stress_now_ns() - start_ns;
+
+    if (ret == 0)
+    {
+        worker->ok[op]++;
+    }
+    else
+    {
+        worker->fail[op]++;
+    }
+}
+
+/**
+ * @brief 操作线程
+ *
+ * @note 每次随机选择一个槽位和一个操作，所有线程共享同一组定时器
+ *
+ * @param[in,out] arg: 线程参数
+ *
+ * @return NULL
+ */
+static void *hs_timer_stress_thread(void *arg)
+{
+    hs_timer_stress_worker_t *worker = (hs_timer_stress_worker_t *)arg;
+    const hs_timer_stress_config_t *config = worker->config;
+
+    while (!__atomic_load_n(worker->start, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+
+    while (!__atomic_load_n(worker->stop, __ATOMIC_RELAXED))
+    {
+        uint64_t r = hs_timer_stress_next(&worker->rng);
+        hs_timer_stress_slot_t *slot = &worker->slots[r % config->slots];
+        hs_timer_stress_op_e op = s_op_table[(r >> 32) % (sizeof(s_op_table) / sizeof(s_op_table[0]))];
+
+        if ((op == E_HS_TIMER_STRESS_OP_DESTROY) || (op == E_HS_TIMER_STRESS_OP_DESTROY_SYNC) ||
+            (op == E_HS_TIMER_STRESS_OP_EXPIRE_SYNC))
+        {
+            hs_timer_stress_replace(worker, slot, op);
+
+            continue;
+        }
+
+        // 登记后再读取定时器，销毁方取下定时器后等待登记数归 0
+        __atomic_add_fetch(&slot->users, 1, __ATOMIC_SEQ_CST);
+        hs_timer_t *hs_timer = __atomic_load_n(&slot->hs_timer, __ATOMIC_SEQ_CST);
+        if (hs_timer != NULL)
+        {
+            hs_timer_stress_apply(worker, hs_timer, __atomic_load_n(&slot->on_storage, __ATOMIC_RELAXED), op);
+        }
+        __atomic_sub_fetch(&slot->users, 1, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 输出使用说明
+ *
+ * @param[in] name: 程序名
+ */
+static void hs_timer_stress_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --threads N             operation threads sharing the timers (1 ~ %u, default 8)\n"
+            "  --slots N               shared timers (default 64)\n"
+            "  --workers N             engine callback worker threads (default 2)\n"
+            "  --run-ms N              duration of the run (default 2000)\n"
+            "  --max-timeout-us N      upper bound of the random timeouts (default 2000)\n"
+            "  --seed N                random seed (default: current time)\n",
+            name, HS_TIMER_STRESS_MAX_THREADS);
+}
+
+int main(int argc, char *argv[])
+{
+    hs_timer_stress_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.threads = 8;
+    config.slots = 64;
+    config.workers = 2;
+    config.run_ns = 2000ULL * HS_TIMER_STRESS_NSEC_PER_MSEC;
+    config.max_timeout_ns = 2000ULL * HS_TIMER_STRESS_NSEC_PER_USEC;
+    config.seed = hs_timer_stress_now_ns();
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            hs_timer_stress_usage(argv[0]);
+
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--threads") == 0)
+        {
+            config.threads = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--slots") == 0)
+        {
+            config.slots = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--workers") == 0)
+        {
+            config.workers = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--run-ms") == 0)
+        {
+            config.run_ns = strtoull(value, NULL, 10) * HS_TIMER_STRESS_NSEC_PER_MSEC;
+        }
+        else if (strcmp(argv[i], "--max-timeout-us") == 0)
+        {
+            config.max_timeout_ns = strtoull(value, NULL, 10) * HS_TIMER_STRESS_NSEC_PER_USEC;
+        }
+        else if (strcmp(argv[i], "--seed") == 0)
+        {
+            config.seed = strtoull(value, NULL, 10);
+        }
+        else
+        {
+            hs_timer_stress_usage(argv[0]);
+
+            return 1;
+        }
+        i++;
+    }
+    if ((config.threads == 0) || (config.threads > HS_TIMER_STRESS_MAX_THREADS) || (config.slots == 0) ||
+        (config.max_timeout_ns == 0))
+    {
+        hs_timer_stress_usage(argv[0]);
+
+        return 1;
+    }
+
+    hs_timer_engine_config_t engine_config;
+    hs_timer_engine_config_init(&engine_config);
+    engine_config.worker_count = config.workers;
+    engine_config.high_worker_count = (config.workers > 0) ? 1 : 0;
+    hs_timer_engine_t *engine = hs_timer_engine_create(&engine_config);
+    hs_timer_stress_slot_t *slots =
+        (hs_timer_stress_slot_t *)aligned_alloc(64, sizeof(hs_timer_stress_slot_t) * config.slots);
+    static hs_timer_stress_worker_t workers[HS_TIMER_STRESS_MAX_THREADS];
+    if ((engine == NULL) || (slots == NULL))
+    {
+        fprintf(stderr, "hs_timer_stress: setup failed\n");
+
+        return 1;
+    }
+    memset(slots, 0, sizeof(hs_timer_stress_slot_t) * config.slots);
+
+    // 启动前先填满槽位
+    hs_timer_stress_worker_t setup;
+    memset(&setup, 0, sizeof(setup));
+    setup.config = &config;
+    setup.engine = engine;
+    setup.rng = (config.seed * 0x9E3779B97F4A7C15ULL) | 1;
+    for (uint32_t i = 0; i < config.slots; i++)
+    {
+        slots[i].hs_timer = hs_timer_stress_spawn(&setup, &slots[i]);
+    }
+
+    bool start = false;
+    bool stop = false;
+    uint32_t started = 0;
+    for (; started < config.threads; started++)
+    {
+        hs_timer_stress_worker_t *worker = &workers[started];
+        memset(worker, 0, sizeof(hs_timer_stress_worker_t));
+        worker->config = &config;
+        worker->engine = engine;
+        worker->slots = slots;
+        worker->start = &start;
+        worker->stop = &stop;
+        worker->rng = ((config.seed + started + 1) * 0x9E3779B97F4A7C15ULL) | 1;
+        if (pthread_create(&worker->thread, NULL, hs_timer_stress_thread, worker) != 0)
+        {
+            break;
+        }
+    }
+
+    uint64_t start_ns = hs_timer_stress_now_ns();
+    __atomic_store_n(&start, true, __ATOMIC_RELEASE);
+    struct timespec ts;
+    ts.tv_sec = (time_t)(config.run_ns / HS_TIMER_STRESS_NSEC_PER_SEC);
+    ts.tv_nsec = (long)(config.run_ns % HS_TIMER_STRESS_NSEC_PER_SEC);
+    nanosleep(&ts, NULL);
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < started; i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+    }
+    uint64_t elapsed_ns = hs_timer_stress_now_ns() - start_ns;
+
+    // 同步销毁剩余的定时器，之后引擎应已回收全部定时器
+    for (uint32_t i = 0; i < config.slots; i++)
+    {
+        if ((slots[i].hs_timer != NULL) && (hs_timer_destroy_sync(slots[i].hs_timer) != 0))
+        {
+            hs_timer_stress_violation("destroying a live timer failed");
+        }
+    }
+    uint64_t drain_ns = hs_timer_stress_now_ns();
+    while ((__atomic_load_n(&s_released, __ATOMIC_ACQUIRE) != __atomic_load_n(&s_created, __ATOMIC_RELAXED)) &&
+           (hs_timer_stress_now_ns() - drain_ns < HS_TIMER_STRESS_DRAIN_NS))
+    {
+        usleep(1000);
+    }
+    if (__atomic_load_n(&s_released, __ATOMIC_ACQUIRE) != s_created)
+    {
+        hs_timer_stress_violation("not every created timer was released");
+    }
+    if (hs_timer_engine_destroy(engine) != 0)
+    {
+        hs_timer_stress_violation("hs_timer_engine_destroy() failed");
+    }
+
+    printf("{\n  \"stress\": \"hs_timer\",\n  \"config\": {\"threads\": %u, \"slots\": %u, \"workers\": %u, "
+           "\"run_ns\": %llu, \"max_timeout_ns\": %llu, \"seed\": %llu},\n  \"results\": [",
+           config.threads, config.slots, config.workers, (unsigned long long)config.run_ns,
+           (unsigned long long)config.max_timeout_ns, (unsigned long long)config.seed);
+    double seconds = (double)elapsed_ns / (double)HS_TIMER_STRESS_NSEC_PER_SEC;
+    for (uint32_t op = 0; op < E_HS_TIMER_STRESS_OP_MAX; op++)
+    {
+        uint64_t ok = 0;
+        uint64_t fail = 0;
+        uint64_t ns = 0;
+        for (uint32_t i = 0; i < started; i++)
+        {
+            ok += workers[i].ok[op];
+            fail += workers[i].fail[op];
+            ns += workers[i].ns[op];
+        }
+
+        // 吞吐量为所有线程合计的调用次数，平均耗时为单次调用在调用线程中的耗时
+        uint64_t calls = ok + fail;
+        printf("%s\n    {\"op\": \"%s\", \"ok\": %llu, \"rejected\": %llu, \"ops_per_sec\": %.0f, \"avg_ns\": %.1f}",
+               (op == 0) ? "" : ",", s_op_names[op], (unsigned long long)ok, (unsigned long long)fail,
+               (seconds > 0.0) ? ((double)calls / seconds) : 0.0, (calls > 0) ? ((double)ns / (double)calls) : 0.0);
+    }
+    printf("\n  ],\n  \"seconds\": %.6f, \"callbacks\": %llu, \"created\": %llu, \"released\": %llu, "
+           "\"violations\": %llu\n}\n",
+           seconds, (unsigned long long)s_callbacks, (unsigned long long)s_created, (unsigned long long)s_released,
+           (unsigned long long)s_violations);
+    free(slots);
+
+    return (s_violations == 0) ? 0 : 1;
+}
@@ -9,34 +9,142 @@
  */
 
 #include <stdio.h>
-#include <time.h>
-#include <signal.h>
-#include <pthread.h>
 #include <string.h>
 #include <stdlib.h>
+#include <assert.h>
 
 #include "hs_timer.h"
+#include "hs_timer_internal.h"
 
-// 定时器状态
-typedef enum hs_timer_status
+static_assert(sizeof(hs_timer_t) <= sizeof(hs_timer_storage_t), "HS_TIMER_STORAGE_SIZE is too small");
+static_assert(_Alignof(hs_timer_t) <= _Alignof(hs_timer_storage_t), "hs_timer_storage_t is under-aligned");
+
+#define HS_TIMER_STATUS_BIT(status) (1U << (status)) // 状态对应的位
+
+// 序列化上下文
+typedef struct hs_timer_serialize_ctx
+{
+    uint8_t *buf;   // 输出缓冲区 (NULL: 只计算大小)
+    size_t size;    // 输出缓冲区大小
+    size_t length;  // 已写入 (或所需) 的大小
+    uint64_t count; // 记录数量
+} hs_timer_serialize_ctx_t;
+
+// 当前线程正在执行回调的定时器
+static __thread hs_timer_t *s_current_timer = NULL;
+
+// 当前线程正在执行的批量回调的定时器
+static __thread hs_timer_t *const *s_current_batch = NULL;
+static __thread size_t s_current_batch_count = 0;
+
+#ifdef HS_TIMER_ENABLE_TRACE
+hs_timer_trace_cb g_hs_timer_trace_cb = NULL;
+#endif
+
+/**
+ * @brief 读取定时器状态
+ *
+ * @param[in] hs_timer: 定时器对象
+ *
+ * @return 定时器状态
+ */
+static inline hs_timer_status_e hs_timer_load_status(const hs_timer_t *hs_timer)
+{
+    return __atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief 内部状态转换为查看用的状态 (跟踪事件参数)
+ *
+ * @param[in] status: 定时器状态
+ *
+ * @return 查看用的状态
+ */
+static inline uint64_t hs_timer_trace_state(const hs_timer_status_e status)
+{
+    switch (status)
+    {
+    case E_HS_TIMER_STATUS_RUNNING:
+        return E_HS_TIMER_STATE_RUNNING;
+
+    case E_HS_TIMER_STATUS_PAUSED:
+        return E_HS_TIMER_STATE_PAUSED;
+
+    case E_HS_TIMER_STATUS_REQUEST_DESTROY:
+        return E_HS_TIMER_STATE_DESTROYING;
+
+    default:
+        return E_HS_TIMER_STATE_CREATED;
+    }
+}
+
+/**
+ * @brief 记录状态切换的跟踪事件
+ *
+ * @param[in] hs_timer: 定时器对象
+ * @param[in] from    : 切换前的状态
+ * @param[in] to      : 新状态
+ */
+static inline void hs_timer_trace_transition(const hs_timer_t *hs_timer, const hs_timer_status_e from,
+                                             const hs_timer_status_e to)
 {
-    E_HS_TIMER_STATUS_CREATED = 1,     // 已创建
-    E_HS_TIMER_STATUS_RUNNING,         // 运行中
-    E_HS_TIMER_STATUS_PAUSED,          // 已暂停
-    E_HS_TIMER_STATUS_REQUEST_DESTROY, // 请求销毁
-} hs_timer_status_e;
+    switch (to)
+    {
+    case E_HS_TIMER_STATUS_RUNNING:
+        HS_TIMER_TRACE(START, hs_timer, hs_timer_trace_state(from));
+        break;
+
+    case E_HS_TIMER_STATUS_PAUSED:
+        HS_TIMER_TRACE(PAUSE, hs_timer, hs_timer_trace_state(from));
+        break;
+
+    case E_HS_TIMER_STATUS_REQUEST_DESTROY:
+        HS_TIMER_TRACE(DESTROY, hs_timer, hs_timer_trace_state(from));
+        break;
+
+    default:
+        break;
+    }
+}
 
-// 定时器对象
-struct _hs_timer
+/**
+ * @brief 切换定时器状态
+ *
+ * @note 1. 当前状态在 from_mask 中时，原子地切换到 to
+ *       2. 进入 E_HS_TIMER_STATUS_REQUEST_DESTROY 后状态不再改变，from_mask 不应包含该状态
+ *
+ * @param[in,out] hs_timer : 定时器对象
+ * @param[in]     from_mask: 允许切换的当前状态 (HS_TIMER_STATUS_BIT() 按位或)
+ * @param[in]     to       : 新状态
+ * @param[out]    from     : 切换前的状态 (可以为 NULL)
+ *
+ * @return true : 切换成功
+ * @return false: 当前状态不允许切换
+ */
+static bool hs_timer_transition(hs_timer_t *hs_timer, const uint32_t from_mask, const hs_timer_status_e to,
+                                hs_timer_status_e *from)
 {
-    timer_t timer_id;         // 定时器ID
-    pthread_mutex_t mutex;    // 互斥锁
-    hs_timer_status_e status; // 定时器状态
-    hs_timer_cb timer_cb;     // 定时器回调函数
-    uint32_t repeat_count;    // 定时器重复次数 (1: 执行一次; UINT32_MAX: 无限循环)
-    uint32_t timeout_ms;      // 定时器超时时间 (单位: ms)
-    const void *user_data;    // 用户数据
-};
+    hs_timer_status_e status = hs_timer_load_status(hs_timer);
+    bool ret = false;
+
+    while ((from_mask & HS_TIMER_STATUS_BIT(status)) != 0)
+    {
+        if (__atomic_compare_exchange_n(&hs_timer->status, &status, to, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            hs_timer_trace_transition(hs_timer, status, to);
+            ret = true;
+
+            break;
+        }
+    }
+
+    if (from != NULL)
+    {
+        *from = status;
+    }
+
+    return ret;
+}
 
 /**
  * @brief 判断定时器是否可以设置参数
@@ -53,344 +161,1412 @@ static bool hs_timer_can_set_params(const hs_timer_t *hs_timer)
         return false;
     }
 
-    if ((hs_timer->status == E_HS_TIMER_STATUS_CREATED) || (hs_timer->status == E_HS_TIMER_STATUS_RUNNING) ||
-        (hs_timer->status == E_HS_TIMER_STATUS_PAUSED))
+    hs_timer_status_e status = hs_timer_load_status(hs_timer);
+    if ((status == E_HS_TIMER_STATUS_CREATED) || (status == E_HS_TIMER_STATUS_RUNNING) ||
+        (status == E_HS_TIMER_STATUS_PAUSED))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 初始化新分配的定时器对象
+ *
+ * @param[out]    hs_timer: 定时器对象
+ * @param[in,out] engine  : 所属引擎
+ */
+static void hs_timer_setup(hs_timer_t *hs_timer, hs_timer_engine_t *engine)
+{
+    hs_timer_engine_attach(engine, hs_timer);
+    hs_timer->timer_cb = NULL;
+    hs_timer->repeat_count = -1;
+    hs_timer->timeout_ns = 0;
+    hs_timer->user_data = NULL;
+    hs_timer->periodic_mode = E_HS_TIMER_PERIODIC_RELATIVE;
+    hs_timer->priority = E_HS_TIMER_PRIORITY_NORMAL;
+    hs_timer->deadline_ns = 0;
+    hs_timer->overrun = 0;
+    hs_timer->pending_overrun = 0;
+    memset(&hs_timer->stats, 0, sizeof(hs_timer_stats_t));
+    __atomic_store_n(&hs_timer->status, E_HS_TIMER_STATUS_CREATED, __ATOMIC_RELEASE);
+    HS_TIMER_TRACE(CREATE, hs_timer, 0);
+}
+
+/**
+ * @brief 记录新的到期时间
+ *
+ * @note 先写入到期时间再递增启动序号，派发方读到新的序号时一定能读到对应的到期时间
+ *
+ * @param[in,out] hs_timer       : 定时器对象
+ * @param[in]     deadline_ns    : 到期时间 (引擎时钟, 单位: ns)
+ * @param[in]     pending_overrun: 下一次回调合并或跳过的周期数
+ */
+static void hs_timer_store_deadline(hs_timer_t *hs_timer, const uint64_t deadline_ns, const uint32_t pending_overrun)
+{
+    __atomic_store_n(&hs_timer->deadline_ns, deadline_ns, __ATOMIC_RELEASE);
+    __atomic_store_n(&hs_timer->pending_overrun, pending_overrun, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hs_timer->arm_seq, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 获取定时器时钟的当前时间
+ *
+ * @note 分组成员使用分组时钟，其它定时器使用引擎时钟
+ *
+ * @param[in] hs_timer: 定时器对象
+ *
+ * @return 当前时间 (单位: ns)
+ */
+static uint64_t hs_timer_now_ns(const hs_timer_t *hs_timer)
+{
+    return (hs_timer->group != NULL) ? hs_timer_group_now_ns(hs_timer->group) : hs_timer_engine_now_ns(hs_timer->engine);
+}
+
+/**
+ * @brief 将到期时间换算为派发方需要处理的引擎时间
+ *
+ * @param[in] hs_timer   : 定时器对象
+ * @param[in] deadline_ns: 到期时间 (定时器时钟, 单位: ns)
+ *
+ * @return 引擎时间 (单位: ns; HS_TIMER_ENGINE_WAKE_NONE: 分组已暂停，不需要唤醒)
+ */
+static uint64_t hs_timer_wake_ns(const hs_timer_t *hs_timer, const uint64_t deadline_ns)
+{
+    if (hs_timer->group == NULL)
+    {
+        return deadline_ns;
+    }
+
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    if (hs_timer_group_read_clock(hs_timer->group, &hold_ns, &offset_ns))
+    {
+        return HS_TIMER_ENGINE_WAKE_NONE;
+    }
+
+    return (offset_ns > (UINT64_MAX - deadline_ns)) ? HS_TIMER_ENGINE_WAKE_NONE : (deadline_ns + offset_ns);
+}
+
+/**
+ * @brief 计算从当前时间开始的到期时间
+ *
+ * @param[in] hs_timer  : 定时器对象
+ * @param[in] timeout_ns: 超时时间 (单位: ns)
+ *
+ * @return 到期时间 (引擎时钟, 单位: ns)
+ */
+static uint64_t hs_timer_calc_deadline(const hs_timer_t *hs_timer, const uint64_t timeout_ns)
+{
+    uint64_t now_ns = hs_timer_now_ns(hs_timer);
+
+    return (timeout_ns > (UINT64_MAX - now_ns)) ? UINT64_MAX : (now_ns + timeout_ns);
+}
+
+/**
+ * @brief 按到期时间启动定时器
+ *
+ * @note 只有状态为 E_HS_TIMER_STATUS_RUNNING 时，引擎才会把定时器加入时间轮
+ *
+ * @param[in,out] hs_timer   : 定时器对象
+ * @param[in]     deadline_ns: 到期时间 (引擎时钟, 单位: ns)
+ */
+static void hs_timer_arm_at(hs_timer_t *hs_timer, const uint64_t deadline_ns)
+{
+    hs_timer_store_deadline(hs_timer, deadline_ns, 0);
+    hs_timer_engine_submit(hs_timer->engine, hs_timer, hs_timer_wake_ns(hs_timer, deadline_ns));
+}
+
+/**
+ * @brief 启动定时器
+ *
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     timeout_ns: 定时器超时时间 (单位: ns)
+ */
+static void hs_timer_arm(hs_timer_t *hs_timer, const uint64_t timeout_ns)
+{
+    hs_timer_arm_at(hs_timer, hs_timer_calc_deadline(hs_timer, timeout_ns));
+}
+
+/**
+ * @brief 记录一次到期处理的统计
+ *
+ * @note 只在到期处理流程中调用，同一定时器的到期处理不会并发执行
+ *
+ * @param[in,out] hs_timer   : 定时器对象
+ * @param[in]     lateness_ns: 回调开始时间相对到期时间的延迟 (单位: ns)
+ * @param[in]     callback_ns: 回调耗时 (单位: ns)
+ * @param[in]     overrun    : 合并或跳过的周期数
+ */
+static void hs_timer_record(hs_timer_t *hs_timer, const uint64_t lateness_ns, const uint64_t callback_ns,
+                            const uint32_t overrun)
+{
+    hs_timer_stats_t *stats = &hs_timer->stats;
+
+    hs_timer_counter_add(&stats->expired_count, 1);
+    hs_timer_counter_add(&stats->overrun_count, overrun);
+    __atomic_store_n(&stats->last_lateness_ns, lateness_ns, __ATOMIC_RELAXED);
+    if (lateness_ns > stats->max_lateness_ns)
+    {
+        __atomic_store_n(&stats->max_lateness_ns, lateness_ns, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&stats->last_callback_ns, callback_ns, __ATOMIC_RELAXED);
+    if (callback_ns > stats->max_callback_ns)
+    {
+        __atomic_store_n(&stats->max_callback_ns, callback_ns, __ATOMIC_RELAXED);
+    }
+
+    hs_timer_engine_record(hs_timer->engine, lateness_ns, callback_ns, overrun);
+}
+
+/**
+ * @brief 按周期调度策略计算下一次到期时间
+ *
+ * @note 1. 只在到期处理流程中调用，计算结果在结束到期处理时提交给引擎
+ *       2. 绝对到期时间由上一次的到期时间累加周期得到，不受回调耗时和调度延迟影响
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return 下一次到期时间 (引擎时钟, 单位: ns)
+ */
+static uint64_t hs_timer_rearm_periodic(hs_timer_t *hs_timer)
+{
+    hs_timer_periodic_mode_e periodic_mode = __atomic_load_n(&hs_timer->periodic_mode, __ATOMIC_RELAXED);
+    uint64_t period_ns = __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_RELAXED);
+    if (periodic_mode == E_HS_TIMER_PERIODIC_RELATIVE)
+    {
+        uint64_t deadline_ns = hs_timer_calc_deadline(hs_timer, period_ns);
+        hs_timer_store_deadline(hs_timer, deadline_ns, 0);
+
+        return deadline_ns;
+    }
+
+    uint64_t now_ns = hs_timer_now_ns(hs_timer);
+    uint64_t last_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    uint64_t deadline_ns = last_ns + period_ns;
+    uint32_t overrun = 0;
+
+    // 周期为 0 时无法按周期对齐，直接从当前时间开始
+    if (period_ns == 0)
+    {
+        deadline_ns = now_ns;
+    }
+    else if (deadline_ns <= now_ns)
+    {
+        // 上一次到期时间之后已经错过的周期数 (不含下一次到期时间)
+        uint64_t missed = (now_ns - last_ns) / period_ns;
+
+        switch (periodic_mode)
+        {
+        // 跳到当前时间之后的第一个周期
+        case E_HS_TIMER_PERIODIC_SKIP:
+        {
+            deadline_ns = last_ns + ((missed + 1) * period_ns);
+            overrun = (missed > UINT32_MAX) ? UINT32_MAX : (uint32_t)missed;
+
+            break;
+        }
+
+        // 立即执行一次，代表所有错过的周期
+        case E_HS_TIMER_PERIODIC_COALESCE:
+        {
+            deadline_ns = last_ns + (missed * period_ns);
+            overrun = (missed > UINT32_MAX) ? UINT32_MAX : (uint32_t)(missed - 1);
+
+            break;
+        }
+
+        // 到期时间已过，会立即到期，直到追上当前时间
+        case E_HS_TIMER_PERIODIC_CATCH_UP:
+        default:
+        {
+            break;
+        }
+        }
+    }
+
+    hs_timer_store_deadline(hs_timer, deadline_ns, overrun);
+
+    return deadline_ns;
+}
+
+/**
+ * @brief 判断当前线程是否正在执行定时器的回调
+ *
+ * @param[in] hs_timer: 定时器对象
+ *
+ * @return true : 正在执行 (单独回调或所在的批量回调)
+ * @return false: 没有执行
+ */
+static bool hs_timer_in_callback(const hs_timer_t *hs_timer)
+{
+    if (s_current_timer == hs_timer)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < s_current_batch_count; i++)
+    {
+        if (s_current_batch[i] == hs_timer)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 开始定时器的到期处理 (回调函数执行前)
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return true : 需要执行回调函数
+ * @return false: 已请求销毁，已交给引擎释放
+ */
+static bool hs_timer_expire_begin(hs_timer_t *hs_timer)
+{
+    // 已请求销毁，交给引擎释放
+    if (hs_timer_load_status(hs_timer) == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+    {
+        hs_timer_engine_complete(hs_timer->engine, hs_timer, 0);
+
+        return false;
+    }
+
+    // 先把 repeat_count 减一，防止回调函数会根据该值判断是否是最后一次运行或者是否需要销毁定时器
+    uint32_t repeat_count = __atomic_load_n(&hs_timer->repeat_count, __ATOMIC_RELAXED);
+    while ((repeat_count > 0) && (repeat_count < UINT32_MAX))
+    {
+        if (__atomic_compare_exchange_n(&hs_timer->repeat_count, &repeat_count, repeat_count - 1, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            if (repeat_count == 1)
+            {
+                // 由本次到期处理请求销毁，结束处理时交给引擎释放 (其它线程已请求销毁时由其负责)
+                uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                                     HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) |
+                                     HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+                hs_timer->expire_destroy =
+                    hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, NULL);
+            }
+
+            break;
+        }
+    }
+    uint32_t overrun = __atomic_exchange_n(&hs_timer->pending_overrun, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&hs_timer->overrun, overrun, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+/**
+ * @brief 执行一次批量回调
+ *
+ * @note 1. 回调前先取出全部成员，结束处理后成员可能被释放，不能再沿 batch_next 访问
+ *       2. 首个定时器最后结束处理，fork() 后的子进程据此找到被中断的批量回调的其它成员
+ *
+ * @param[in,out] leader: 批量回调的首个定时器
+ */
+static void hs_timer_expire_batch(hs_timer_t *leader)
+{
+    hs_timer_engine_t *engine = leader->engine;
+    hs_timer_group_cb batch_cb = leader->batch_group->batch_cb;
+    void *ctx = leader->batch_group->ctx;
+
+    size_t total = 0;
+    for (hs_timer_t *hs_timer = leader; hs_timer != NULL; hs_timer = hs_timer->batch_next)
+    {
+        total++;
+    }
+
+    // 成员较多时申请内存，申请失败时分多次回调
+    hs_timer_t *stack_timers[HS_TIMER_GROUP_BATCH_STACK];
+    uint64_t stack_lateness[HS_TIMER_GROUP_BATCH_STACK];
+    hs_timer_t **timers = stack_timers;
+    uint64_t *lateness = stack_lateness;
+    size_t capacity = HS_TIMER_GROUP_BATCH_STACK;
+    void *mem = NULL;
+    if (total > HS_TIMER_GROUP_BATCH_STACK)
+    {
+        mem = malloc((sizeof(hs_timer_t *) + sizeof(uint64_t)) * total);
+        if (mem != NULL)
+        {
+            lateness = (uint64_t *)mem;
+            timers = (hs_timer_t **)(lateness + total);
+            capacity = total;
+        }
+    }
+
+    hs_timer_t *next = leader;
+    while (next != NULL)
+    {
+        // 延迟按成员的分组时间计算
+        uint64_t start_ns = hs_timer_engine_now_ns(engine);
+        uint64_t clock_ns = hs_timer_group_now_ns(leader->batch_group);
+        size_t count = 0;
+        while ((next != NULL) && (count < capacity))
+        {
+            hs_timer_t *hs_timer = next;
+            next = hs_timer->batch_next;
+            if (!hs_timer_expire_begin(hs_timer))
+            {
+                continue;
+            }
+
+            // 回调函数中可能重新启动定时器，先取出本次的到期时间
+            uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+            lateness[count] = (clock_ns > deadline_ns) ? (clock_ns - deadline_ns) : 0;
+            timers[count++] = hs_timer;
+        }
+        if (count == 0)
+        {
+            continue;
+        }
+
+        hs_timer_t *const *prev_batch = s_current_batch;
+        size_t prev_count = s_current_batch_count;
+        s_current_batch = timers;
+        s_current_batch_count = count;
+        HS_TIMER_TRACE(CALLBACK_BEGIN, timers[0], count);
+        batch_cb(timers, count, ctx);
+        s_current_batch = prev_batch;
+        s_current_batch_count = prev_count;
+
+        uint64_t end_ns = hs_timer_engine_now_ns(engine);
+        HS_TIMER_TRACE(CALLBACK_END, timers[0], end_ns - start_ns);
+        for (size_t i = 0; i < count; i++)
+        {
+            hs_timer_record(timers[i], lateness[i], end_ns - start_ns,
+                            __atomic_load_n(&timers[i]->overrun, __ATOMIC_RELAXED));
+        }
+
+        // 逆序结束处理，首个定时器最后结束
+        for (size_t i = count; i-- > 0;)
+        {
+            hs_timer_expire_abort(timers[i]);
+        }
+    }
+    free(mem);
+}
+
+void hs_timer_expire(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return;
+    }
+
+    if (hs_timer->batch_group != NULL)
+    {
+        hs_timer_expire_batch(hs_timer);
+
+        return;
+    }
+
+    hs_timer_engine_t *engine = hs_timer->engine;
+    if (!hs_timer_expire_begin(hs_timer))
+    {
+        return;
+    }
+    uint32_t overrun = __atomic_load_n(&hs_timer->overrun, __ATOMIC_RELAXED);
+
+    // 回调函数中可能重新启动定时器，先取出本次的到期时间
+    uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    uint64_t start_ns = hs_timer_engine_now_ns(engine);
+    uint64_t clock_ns = (hs_timer->group != NULL) ? hs_timer_group_now_ns(hs_timer->group) : start_ns;
+    uint64_t lateness_ns = (clock_ns > deadline_ns) ? (clock_ns - deadline_ns) : 0;
+
+    // 用户回调不持有任何锁，在回调函数中可以操作定时器
+    hs_timer_cb timer_cb = __atomic_load_n(&hs_timer->timer_cb, __ATOMIC_ACQUIRE);
+    HS_TIMER_TRACE(CALLBACK_BEGIN, hs_timer, lateness_ns);
+    if (timer_cb != NULL)
+    {
+        hs_timer_t *prev_timer = s_current_timer;
+        s_current_timer = hs_timer;
+        timer_cb(hs_timer);
+        s_current_timer = prev_timer;
+    }
+
+    uint64_t end_ns = hs_timer_engine_now_ns(engine);
+    HS_TIMER_TRACE(CALLBACK_END, hs_timer, end_ns - start_ns);
+    hs_timer_record(hs_timer, lateness_ns, end_ns - start_ns, overrun);
+
+    hs_timer_expire_abort(hs_timer);
+}
+
+void hs_timer_expire_abort(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return;
+    }
+
+    hs_timer_engine_t *engine = hs_timer->engine;
+
+    // 在回调函数中请求了销毁定时器或重复次数归0，立即销毁，万一超时时间很长，销毁速度太慢了
+    hs_timer_status_e status = hs_timer_load_status(hs_timer);
+    if ((status != E_HS_TIMER_STATUS_REQUEST_DESTROY) &&
+        (__atomic_load_n(&hs_timer->repeat_count, __ATOMIC_RELAXED) == 0))
+    {
+        uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                             HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) |
+                             HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+        hs_timer->expire_destroy = hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, NULL);
+        status = E_HS_TIMER_STATUS_REQUEST_DESTROY;
+    }
+    if (status == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+    {
+        // 由到期处理请求的销毁随完成一起交给引擎，其它线程请求的销毁由其自行提交
+        if (hs_timer->expire_destroy)
+        {
+            hs_timer_engine_complete_destroy(engine, hs_timer);
+        }
+        else
+        {
+            hs_timer_engine_complete(engine, hs_timer, 0);
+        }
+
+        return;
+    }
+
+    // 没有请求销毁定时器，则重新启动定时器
+    if (status == E_HS_TIMER_STATUS_RUNNING)
+    {
+        hs_timer_engine_complete(engine, hs_timer, hs_timer_wake_ns(hs_timer, hs_timer_rearm_periodic(hs_timer)));
+
+        return;
+    }
+
+    hs_timer_engine_complete(engine, hs_timer, 0);
+}
+
+hs_timer_t *hs_timer_create(void)
+{
+    return hs_timer_create_on(hs_timer_engine_default());
+}
+
+hs_timer_t *hs_timer_create_on(hs_timer_engine_t *engine)
+{
+    if (engine == NULL)
+    {
+        return NULL;
+    }
+
+    hs_timer_t *hs_timer = hs_timer_engine_alloc_timer(engine, NULL);
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    hs_timer_setup(hs_timer, engine);
+
+    return hs_timer;
+}
+
+/**
+ * @brief 写入分组时钟
+ *
+ * @note 调用方持有分组互斥锁
+ *
+ * @param[in,out] group    : 定时器分组
+ * @param[in]     paused   : 是否暂停
+ * @param[in]     hold_ns  : 分组时间的下限
+ * @param[in]     offset_ns: 引擎时间与分组时间之差
+ */
+static void hs_timer_group_write_clock(hs_timer_group_t *group, const bool paused, const uint64_t hold_ns,
+                                       const uint64_t offset_ns)
+{
+    uint32_t seq = __atomic_load_n(&group->clock_seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&group->clock_seq, seq + 1, __ATOMIC_RELAXED);
+    // 以 release 顺序写入各字段，读取方读到新值时一定能读到奇数的序号
+    __atomic_store_n(&group->paused, paused, __ATOMIC_RELEASE);
+    __atomic_store_n(&group->hold_ns, hold_ns, __ATOMIC_RELEASE);
+    __atomic_store_n(&group->offset_ns, offset_ns, __ATOMIC_RELEASE);
+    __atomic_store_n(&group->clock_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+bool hs_timer_group_read_clock(const hs_timer_group_t *group, uint64_t *hold_ns, uint64_t *offset_ns)
+{
+    bool paused = false;
+    uint32_t seq = 0;
+    do
+    {
+        // 以 acquire 顺序读取各字段，再次读取的序号不会提前到字段之前
+        seq = __atomic_load_n(&group->clock_seq, __ATOMIC_ACQUIRE);
+        paused = __atomic_load_n(&group->paused, __ATOMIC_ACQUIRE);
+        *hold_ns = __atomic_load_n(&group->hold_ns, __ATOMIC_ACQUIRE);
+        *offset_ns = __atomic_load_n(&group->offset_ns, __ATOMIC_ACQUIRE);
+    } while (((seq & 1U) != 0) || (seq != __atomic_load_n(&group->clock_seq, __ATOMIC_RELAXED)));
+
+    return paused;
+}
+
+uint64_t hs_timer_group_now_ns(const hs_timer_group_t *group)
+{
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    if (hs_timer_group_read_clock(group, &hold_ns, &offset_ns))
+    {
+        return hold_ns;
+    }
+
+    return hs_timer_group_time_ns(hold_ns, offset_ns, hs_timer_engine_now_ns(group->engine));
+}
+
+void hs_timer_group_unref(hs_timer_group_t *group)
+{
+    if (__atomic_sub_fetch(&group->ref_count, 1, __ATOMIC_ACQ_REL) != 0)
+    {
+        return;
+    }
+
+    hs_timer_engine_remove_group(group->engine, group);
+    pthread_mutex_destroy(&group->mutex);
+    free(group);
+}
+
+hs_timer_group_t *hs_timer_group_create(hs_timer_engine_t *engine, const hs_timer_group_cb batch_cb, void *ctx)
+{
+    if (engine == NULL)
+    {
+        engine = hs_timer_engine_default();
+        if (engine == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    hs_timer_group_t *group = (hs_timer_group_t *)calloc(1, sizeof(hs_timer_group_t));
+    if (group == NULL)
+    {
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&group->mutex, NULL) != 0)
+    {
+        free(group);
+
+        return NULL;
+    }
+
+    // 分组时间从引擎时间开始；时间轮在首个成员加入时对齐到当前分组时间
+    group->engine = engine;
+    group->batch_cb = batch_cb;
+    group->ctx = ctx;
+    group->ref_count = 1;
+    hs_timer_wheel_init(&group->wheel, 0);
+    hs_timer_engine_add_group(engine, group);
+
+    return group;
+}
+
+int hs_timer_group_destroy(hs_timer_group_t *group)
+{
+    if (group == NULL)
+    {
+        return -1;
+    }
+
+    hs_timer_engine_batch_t batch;
+    hs_timer_engine_batch_init(&batch);
+
+    // 成员在引擎回收时才离开链表，提交前已占用命令队列，不会在提交前被回收
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                         HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    pthread_mutex_lock(&group->mutex);
+    for (hs_timer_t *hs_timer = group->members; hs_timer != NULL; hs_timer = hs_timer->group_next)
+    {
+        if (hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, NULL))
+        {
+            hs_timer_engine_batch_add_destroy(&batch, hs_timer);
+        }
+    }
+    pthread_mutex_unlock(&group->mutex);
+    hs_timer_engine_batch_commit(&batch);
+
+    hs_timer_group_unref(group);
+
+    return 0;
+}
+
+int hs_timer_group_pause(hs_timer_group_t *group)
+{
+    if (group == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&group->mutex);
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    if (!hs_timer_group_read_clock(group, &hold_ns, &offset_ns))
+    {
+        // 派发方读到暂停后不再推进分组时间轮，成员留在其中
+        uint64_t now_ns = hs_timer_group_time_ns(hold_ns, offset_ns, hs_timer_engine_now_ns(group->engine));
+        hs_timer_group_write_clock(group, true, now_ns, offset_ns);
+    }
+    pthread_mutex_unlock(&group->mutex);
+
+    return 0;
+}
+
+int hs_timer_group_resume(hs_timer_group_t *group)
+{
+    if (group == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&group->mutex);
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    bool paused = hs_timer_group_read_clock(group, &hold_ns, &offset_ns);
+    if (paused)
+    {
+        // 分组时间从暂停时继续 (再推迟暂停期间累计的时间)，成员的剩余时间不变
+        uint64_t now_ns = hs_timer_engine_now_ns(group->engine);
+        uint64_t shift_ns = (now_ns > hold_ns) ? (now_ns - hold_ns) : 0;
+        offset_ns = (group->delay_ns > (UINT64_MAX - shift_ns)) ? UINT64_MAX : (shift_ns + group->delay_ns);
+        group->delay_ns = 0;
+        hs_timer_group_write_clock(group, false, hold_ns, offset_ns);
+    }
+    pthread_mutex_unlock(&group->mutex);
+
+    // 派发方需要重新计算下一次唤醒时间
+    if (paused)
+    {
+        hs_timer_engine_notify(group->engine);
+    }
+
+    return 0;
+}
+
+int hs_timer_group_postpone_ns(hs_timer_group_t *group, const uint64_t delay_ns)
+{
+    if (group == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&group->mutex);
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    if (hs_timer_group_read_clock(group, &hold_ns, &offset_ns))
+    {
+        group->delay_ns = (delay_ns > (UINT64_MAX - group->delay_ns)) ? UINT64_MAX : (group->delay_ns + delay_ns);
+    }
+    else
+    {
+        // 分组时间停在当前值，直到引擎时间再经过 delay_ns
+        uint64_t now_ns = hs_timer_engine_now_ns(group->engine);
+        uint64_t group_ns = hs_timer_group_time_ns(hold_ns, offset_ns, now_ns);
+        uint64_t shift_ns = (now_ns > group_ns) ? (now_ns - group_ns) : 0;
+        offset_ns = (delay_ns > (UINT64_MAX - shift_ns)) ? UINT64_MAX : (shift_ns + delay_ns);
+        hs_timer_group_write_clock(group, false, group_ns, offset_ns);
+    }
+    pthread_mutex_unlock(&group->mutex);
+
+    return 0;
+}
+
+bool hs_timer_group_is_paused(hs_timer_group_t *group)
+{
+    if (group == NULL)
+    {
+        return false;
+    }
+
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+
+    return hs_timer_group_read_clock(group, &hold_ns, &offset_ns);
+}
+
+hs_timer_t *hs_timer_create_in_group(hs_timer_group_t *group)
+{
+    if (group == NULL)
+    {
+        return NULL;
+    }
+
+    hs_timer_t *hs_timer = hs_timer_create_on(group->engine);
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    // 定时器还未交给用户，分组在启动前写入即可被派发方看到
+    __atomic_add_fetch(&group->ref_count, 1, __ATOMIC_RELAXED);
+    hs_timer->group = group;
+    pthread_mutex_lock(&group->mutex);
+    hs_timer->group_prev = NULL;
+    hs_timer->group_next = group->members;
+    if (group->members != NULL)
+    {
+        group->members->group_prev = hs_timer;
+    }
+    group->members = hs_timer;
+    pthread_mutex_unlock(&group->mutex);
+
+    return hs_timer;
+}
+
+hs_timer_t *hs_timer_init_static(hs_timer_storage_t *storage, hs_timer_engine_t *engine)
+{
+    if (storage == NULL)
+    {
+        return NULL;
+    }
+
+    if (engine == NULL)
+    {
+        engine = hs_timer_engine_default();
+        if (engine == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    hs_timer_t *hs_timer = hs_timer_engine_alloc_timer(engine, storage);
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    hs_timer_setup(hs_timer, engine);
+
+    return hs_timer;
+}
+
+int hs_timer_init(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32_t repeat_count,
+                  const uint32_t timeout_ms, const void *user_data)
+{
+    return hs_timer_init_ns(hs_timer, timer_cb, repeat_count, (uint64_t)timeout_ms * HS_TIMER_NSEC_PER_MSEC, user_data);
+}
+
+int hs_timer_init_ns(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32_t repeat_count,
+                     const uint64_t timeout_ns, const void *user_data)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    // 启动前定时器可能因重复次数用完被自动销毁，提交完成前引擎不会释放
+    hs_timer_engine_enter(hs_timer);
+    if (!hs_timer_can_set_params(hs_timer))
+    {
+        hs_timer_engine_leave(hs_timer);
+
+        return -2;
+    }
+
+    __atomic_store_n(&hs_timer->timer_cb, timer_cb, __ATOMIC_RELEASE);
+    __atomic_store_n(&hs_timer->repeat_count, repeat_count, __ATOMIC_RELAXED);
+    __atomic_store_n(&hs_timer->timeout_ns, timeout_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&hs_timer->user_data, user_data, __ATOMIC_RELEASE);
+    __atomic_store_n(&hs_timer->overrun, 0, __ATOMIC_RELAXED);
+
+    // 定时器已初始化时，重新启动会替换之前的到期时间
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                         HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    bool ret = hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_RUNNING, NULL);
+    if (ret)
+    {
+        hs_timer_arm(hs_timer, timeout_ns);
+    }
+    hs_timer_engine_leave(hs_timer);
+
+    return ret ? 0 : -2;
+}
+
+int hs_timer_destroy(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    // 切换状态后派发方可能随时回收对象，需要先取出所属引擎
+    hs_timer_engine_t *engine = hs_timer->engine;
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                         HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    hs_timer_status_e status = E_HS_TIMER_STATUS_UNUSED;
+    if (!hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, &status))
+    {
+        // 销毁中，忽略
+        return (status == E_HS_TIMER_STATUS_REQUEST_DESTROY) ? 0 : -2;
+    }
+
+    // 通知引擎立即从时间轮中移除并释放 (正在执行到期处理时，在处理结束后释放)
+    hs_timer_engine_submit_destroy(engine, hs_timer);
+
+    return 0;
+}
+
+int hs_timer_destroy_sync(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    // 在自己的回调函数中等待自己的回调结束会死锁
+    if (hs_timer_in_callback(hs_timer))
+    {
+        return -2;
+    }
+
+    // 在派发方中 (回调直接在派发方执行时) 不能等待，此时该定时器的回调一定没有在执行
+    hs_timer_engine_t *engine = hs_timer->engine;
+    if (hs_timer_engine_is_dispatching(engine))
+    {
+        return hs_timer_destroy(hs_timer);
+    }
+
+    // 先登记完成标志再请求销毁，派发方开始释放前登记的一定能看到
+    bool release_done = false;
+    bool *expected = NULL;
+    if (!__atomic_compare_exchange_n(&hs_timer->release_done, &expected, &release_done, false, __ATOMIC_SEQ_CST,
+                                     __ATOMIC_SEQ_CST))
+    {
+        // 派发方已开始释放 (例如最后一次回调刚结束)，回调不会再执行，释放回调函数已调用
+        if (expected == HS_TIMER_RELEASED)
+        {
+            return 0;
+        }
+
+        // 已有其它线程在同步销毁
+        return -2;
+    }
+
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                         HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    if (hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, NULL))
+    {
+        hs_timer_engine_submit_destroy(engine, hs_timer);
+    }
+
+    // 已在销毁中 (例如最后一次回调正在执行) 时同样等待释放，派发方释放时一定会取走登记的完成标志
+    hs_timer_engine_wait_release(engine, &release_done);
+
+    return 0;
+}
+
+int hs_timer_set_cb(hs_timer_t *hs_timer, const hs_timer_cb timer_cb)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    if (!hs_timer_can_set_params(hs_timer))
+    {
+        return -2;
+    }
+
+    __atomic_store_n(&hs_timer->timer_cb, timer_cb, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+int hs_timer_set_repeat_count(hs_timer_t *hs_timer, const uint32_t repeat_count)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    if (!hs_timer_can_set_params(hs_timer))
+    {
+        return -2;
+    }
+
+    __atomic_store_n(&hs_timer->repeat_count, repeat_count, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int hs_timer_set_timeout(hs_timer_t *hs_timer, const uint32_t timeout_ms)
+{
+    return hs_timer_set_timeout_ns(hs_timer, (uint64_t)timeout_ms * HS_TIMER_NSEC_PER_MSEC);
+}
+
+int hs_timer_set_timeout_ns(hs_timer_t *hs_timer, const uint64_t timeout_ns)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    hs_timer_engine_enter(hs_timer);
+    if (!hs_timer_can_set_params(hs_timer))
+    {
+        hs_timer_engine_leave(hs_timer);
+
+        return -2;
+    }
+
+    __atomic_store_n(&hs_timer->timeout_ns, timeout_ns, __ATOMIC_RELAXED);
+
+    // 未运行的定时器只更新超时时间，启动或恢复时生效
+    if (hs_timer_load_status(hs_timer) == E_HS_TIMER_STATUS_RUNNING)
+    {
+        hs_timer_arm(hs_timer, timeout_ns);
+    }
+    hs_timer_engine_leave(hs_timer);
+
+    return 0;
+}
+
+int hs_timer_touch(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    return hs_timer_postpone_ns(hs_timer, __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_RELAXED));
+}
+
+int hs_timer_postpone(hs_timer_t *hs_timer, const uint32_t delay_ms)
+{
+    return hs_timer_postpone_ns(hs_timer, (uint64_t)delay_ms * HS_TIMER_NSEC_PER_MSEC);
+}
+
+int hs_timer_postpone_ns(hs_timer_t *hs_timer, const uint64_t delay_ns)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    hs_timer_engine_enter(hs_timer);
+    if (hs_timer_load_status(hs_timer) != E_HS_TIMER_STATUS_RUNNING)
+    {
+        hs_timer_engine_leave(hs_timer);
+
+        return -2;
+    }
+
+    // 只推迟时直接更新到期时间，原到期时间到达时引擎发现未到期再重新加入时间轮
+    uint64_t deadline_ns = hs_timer_calc_deadline(hs_timer, delay_ns);
+    uint64_t current_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    while (deadline_ns >= current_ns)
     {
-        return true;
+        if (__atomic_compare_exchange_n(&hs_timer->deadline_ns, &current_ns, deadline_ns, true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+        {
+            hs_timer_engine_leave(hs_timer);
+
+            return 0;
+        }
     }
 
-    return false;
+    // 提前到期无法延后处理，按重新启动处理
+    hs_timer_arm_at(hs_timer, deadline_ns);
+    hs_timer_engine_leave(hs_timer);
+
+    return 0;
 }
 
 /**
- * @brief 将毫秒转换为 itimerspec 结构体
- *
- * @note 该函数只适用于单次定时器
+ * @brief 结束批量调用中每个定时器的 hs_timer_engine_enter()
  *
- * @param[in]  ms        : 毫秒数
- * @param[out] timer_spec: 转换后的 itimerspec 结构体
- *
- * @return 0 : 成功
- * @return <0: 失败
+ * @param[in,out] hs_timers: 定时器对象数组 (NULL 元素跳过)
+ * @param[in]     count    : 数组元素个数
  */
-static int hs_timer_ms_to_timespec_one_shot(const uint32_t ms, struct itimerspec *timer_spec)
+static void hs_timer_leave_batch(hs_timer_t **hs_timers, const size_t count)
 {
-    if (timer_spec == NULL)
+    for (size_t i = 0; i < count; i++)
     {
-        return -1;
+        if (hs_timers[i] != NULL)
+        {
+            hs_timer_engine_leave(hs_timers[i]);
+        }
     }
-
-    // 因为使用 one-shot 模式，这里不设置 it_interval。在回调函数中，根据 repeat_count 决定是否再次启动
-    timer_spec->it_interval.tv_sec = 0;
-    timer_spec->it_interval.tv_nsec = 0;
-
-    timer_spec->it_value.tv_sec = ms / 1000;
-    timer_spec->it_value.tv_nsec = (ms % 1000) * 1000000;
-
-    return 0;
 }
 
-/**
- * @brief 定时器回调线程
- *
- * @param[in] sigev_value: 用户自定义参数，在调用timer_create()时传入
- */
-static void hs_timer_thread(union sigval sigev_value)
+int hs_timer_arm_batch(hs_timer_t **hs_timers, const uint64_t *timeouts_ns, const size_t count)
 {
-    hs_timer_t *hs_timer = (hs_timer_t *)sigev_value.sival_ptr;
-    if (hs_timer == NULL)
+    if ((hs_timers == NULL) && (count != 0))
     {
-        return;
+        return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
+    hs_timer_engine_batch_t batch;
+    hs_timer_engine_batch_init(&batch);
 
-    // 已请求销毁，则销毁定时器
-    if (hs_timer->status == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    hs_timer_engine_t *engine = NULL;
+    hs_timer_group_t *group = NULL;
+    uint64_t now_ns = 0;
+    int armed = 0;
+    for (size_t i = 0; i < count; i++)
     {
-        timer_delete(hs_timer->timer_id);
-        pthread_mutex_unlock(&hs_timer->mutex);
-        pthread_mutex_destroy(&hs_timer->mutex);
-        free(hs_timer);
+        hs_timer_t *hs_timer = hs_timers[i];
+        if (hs_timer == NULL)
+        {
+            continue;
+        }
 
-        return;
-    }
+        // 提交完成前引擎不会释放其中自动销毁的定时器
+        hs_timer_engine_enter(hs_timer);
+        if (!hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_RUNNING, NULL))
+        {
+            continue;
+        }
 
-    // 先把 repeat_count 减一，防止回调函数会根据该值判断是否是最后一次运行或者是否需要销毁定时器
-    if ((hs_timer->repeat_count > 0) && (hs_timer->repeat_count < UINT32_MAX))
-    {
-        hs_timer->repeat_count--;
+        uint64_t timeout_ns = 0;
+        if (timeouts_ns != NULL)
+        {
+            timeout_ns = timeouts_ns[i];
+            __atomic_store_n(&hs_timer->timeout_ns, timeout_ns, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            timeout_ns = __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_RELAXED);
+        }
 
-        if (hs_timer->repeat_count == 0)
+        // 同一引擎 (同一分组) 的定时器共用一次时钟读取
+        if ((hs_timer->engine != engine) || (hs_timer->group != group))
         {
-            hs_timer->status = E_HS_TIMER_STATUS_REQUEST_DESTROY;
+            engine = hs_timer->engine;
+            group = hs_timer->group;
+            now_ns = hs_timer_now_ns(hs_timer);
         }
-    }
-    pthread_mutex_unlock(&hs_timer->mutex);
 
-    // 用户回调不加锁，防止在回调函数设置参数等造成死锁
-    if (hs_timer->timer_cb != NULL)
-    {
-        hs_timer->timer_cb(hs_timer);
+        hs_timer_store_deadline(hs_timer, (timeout_ns > (UINT64_MAX - now_ns)) ? UINT64_MAX : (now_ns + timeout_ns),
+                                0);
+        hs_timer_engine_batch_add(&batch, hs_timer);
+        armed++;
     }
+    hs_timer_engine_batch_commit(&batch);
+    hs_timer_leave_batch(hs_timers, count);
 
-    // 在回调函数中请求了销毁定时器或重复次数归0，立即销毁，万一超时时间很长，销毁速度太慢了
-    pthread_mutex_lock(&hs_timer->mutex);
-    if ((hs_timer->status == E_HS_TIMER_STATUS_REQUEST_DESTROY) || (hs_timer->repeat_count == 0))
-    {
-        timer_delete(hs_timer->timer_id);
-        pthread_mutex_unlock(&hs_timer->mutex);
-        pthread_mutex_destroy(&hs_timer->mutex);
-        free(hs_timer);
+    return armed;
+}
 
-        return;
+int hs_timer_cancel_batch(hs_timer_t **hs_timers, const size_t count)
+{
+    if ((hs_timers == NULL) && (count != 0))
+    {
+        return -1;
     }
 
-    // 没有请求销毁定时器，则重新启动定时器
-    if ((hs_timer->status == E_HS_TIMER_STATUS_RUNNING) && (hs_timer->repeat_count != 0))
+    hs_timer_engine_batch_t batch;
+    hs_timer_engine_batch_init(&batch);
+
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    int canceled = 0;
+    for (size_t i = 0; i < count; i++)
     {
-        struct itimerspec timer_spec = {0};
-        if (hs_timer_ms_to_timespec_one_shot(hs_timer->timeout_ms, &timer_spec) != 0)
+        hs_timer_t *hs_timer = hs_timers[i];
+        if (hs_timer == NULL)
         {
-            pthread_mutex_unlock(&hs_timer->mutex);
+            continue;
+        }
 
-            return;
+        hs_timer_engine_enter(hs_timer);
+        hs_timer_status_e status = E_HS_TIMER_STATUS_UNUSED;
+        if (!hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_PAUSED, &status))
+        {
+            continue;
         }
 
-        timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL);
+        if (status == E_HS_TIMER_STATUS_RUNNING)
+        {
+            hs_timer_engine_batch_add(&batch, hs_timer);
+        }
+        canceled++;
     }
+    hs_timer_engine_batch_commit(&batch);
+    hs_timer_leave_batch(hs_timers, count);
 
-    pthread_mutex_unlock(&hs_timer->mutex);
+    return canceled;
 }
 
-hs_timer_t *hs_timer_create(void)
+int hs_timer_destroy_batch(hs_timer_t **hs_timers, const size_t count)
 {
-    hs_timer_t *hs_timer = (hs_timer_t *)malloc(sizeof(hs_timer_t));
-    if (hs_timer == NULL)
+    if ((hs_timers == NULL) && (count != 0))
     {
-        return NULL;
+        return -1;
     }
 
-    hs_timer->status = E_HS_TIMER_STATUS_CREATED;
-    hs_timer->timer_cb = NULL;
-    hs_timer->repeat_count = -1;
-    hs_timer->timeout_ms = 0;
-    hs_timer->user_data = NULL;
-    pthread_mutex_init(&hs_timer->mutex, NULL);
+    hs_timer_engine_batch_t batch;
+    hs_timer_engine_batch_init(&batch);
 
-    return hs_timer;
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_CREATED) |
+                         HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    int destroyed = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        hs_timer_t *hs_timer = hs_timers[i];
+        if ((hs_timer == NULL) || !hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_REQUEST_DESTROY, NULL))
+        {
+            continue;
+        }
+
+        // 运行中的定时器也一起提交，引擎立即释放，不等到期
+        hs_timer_engine_batch_add_destroy(&batch, hs_timer);
+        destroyed++;
+    }
+    hs_timer_engine_batch_commit(&batch);
+
+    return destroyed;
 }
 
-int hs_timer_init(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32_t repeat_count,
-                  const uint32_t timeout_ms, const void *user_data)
+/**
+ * @brief 将一个定时器写入快照 (hs_timer_engine_foreach() 的回调)
+ *
+ * @note 缓冲区不足时继续遍历，只累加所需大小
+ *
+ * @param[in]     info: 定时器快照
+ * @param[in,out] arg : 序列化上下文
+ *
+ * @return 0: 继续遍历
+ */
+static int hs_timer_serialize_one(const hs_timer_info_t *info, void *arg)
 {
-    if (hs_timer == NULL)
+    hs_timer_serialize_ctx_t *ctx = (hs_timer_serialize_ctx_t *)arg;
+    if (info->state == E_HS_TIMER_STATE_DESTROYING)
     {
-        return -1;
+        return 0;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-
-    // 定时器已初始化，关闭后再初始化
-    if (hs_timer->status != E_HS_TIMER_STATUS_CREATED)
+    if ((ctx->buf != NULL) && ((ctx->length + sizeof(hs_timer_snapshot_record_t)) <= ctx->size))
     {
-        timer_delete(hs_timer->timer_id);
+        hs_timer_snapshot_record_t record = {0};
+        record.remaining_ns = info->remaining_ns;
+        record.timeout_ns = info->timeout_ns;
+        record.timer_cb = info->timer_cb;
+        record.user_data = info->user_data;
+        record.repeat_count = info->repeat_count;
+        record.state = (uint8_t)info->state;
+        record.periodic_mode = (uint8_t)info->periodic_mode;
+        record.priority = (uint8_t)info->priority;
+        memcpy(ctx->buf + ctx->length, &record, sizeof(record));
     }
+    ctx->length += sizeof(hs_timer_snapshot_record_t);
+    ctx->count++;
 
-    struct sigevent sig_event = {0};
-    memset(&sig_event, 0, sizeof(struct sigevent));
-    sig_event.sigev_notify = SIGEV_THREAD;
-    sig_event.sigev_notify_function = hs_timer_thread;
-    sig_event.sigev_value.sival_ptr = hs_timer;
-    // CLOCK_MONOTONIC: 获取的时间为系统重启到现在的时间, 更改系统时间对其没有影响
-    if (timer_create(CLOCK_MONOTONIC, &sig_event, &hs_timer->timer_id) == -1)
-    {
-        pthread_mutex_unlock(&hs_timer->mutex);
+    return 0;
+}
 
-        return -3;
+int hs_timer_engine_serialize(hs_timer_engine_t *engine, void *buf, const size_t size, size_t *length)
+{
+    if ((engine == NULL) || (length == NULL))
+    {
+        return -1;
     }
 
-    struct itimerspec timer_spec = {0};
-    if (hs_timer_ms_to_timespec_one_shot(timeout_ms, &timer_spec) != 0)
+    hs_timer_serialize_ctx_t ctx = {0};
+    ctx.buf = (uint8_t *)buf;
+    ctx.size = size;
+    ctx.length = sizeof(hs_timer_snapshot_header_t);
+    if (hs_timer_engine_foreach(engine, hs_timer_serialize_one, &ctx) < 0)
     {
-        timer_delete(hs_timer->timer_id);
-        pthread_mutex_unlock(&hs_timer->mutex);
-
-        return -4;
+        return -2;
     }
 
-    if (timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL) == -1)
+    *length = ctx.length;
+    if ((buf == NULL) || (ctx.length > size))
     {
-        timer_delete(hs_timer->timer_id);
-        pthread_mutex_unlock(&hs_timer->mutex);
-
-        return -5;
+        return -3;
     }
 
-    hs_timer->status = E_HS_TIMER_STATUS_RUNNING;
-    hs_timer->timer_cb = timer_cb;
-    hs_timer->repeat_count = repeat_count;
-    hs_timer->timeout_ms = timeout_ms;
-    hs_timer->user_data = user_data;
-
-    pthread_mutex_unlock(&hs_timer->mutex);
+    hs_timer_snapshot_header_t header = {0};
+    header.magic = HS_TIMER_SNAPSHOT_MAGIC;
+    header.version = HS_TIMER_SNAPSHOT_VERSION;
+    header.record_size = sizeof(hs_timer_snapshot_record_t);
+    header.count = ctx.count;
+    memcpy(buf, &header, sizeof(header));
 
     return 0;
 }
 
-int hs_timer_destroy(hs_timer_t *hs_timer)
+int hs_timer_engine_rehydrate(hs_timer_engine_t *engine, const void *buf, const size_t length, hs_timer_t **timers,
+                              const size_t capacity)
 {
-    if (hs_timer == NULL)
+    if ((engine == NULL) || (buf == NULL) || (timers == NULL))
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-
-    switch (hs_timer->status)
-    {
-    // 未初始化，立即销毁
-    case E_HS_TIMER_STATUS_CREATED:
+    hs_timer_snapshot_header_t header;
+    if (length < sizeof(header))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-        pthread_mutex_destroy(&hs_timer->mutex);
-        free(hs_timer);
-
-        return 0;
+        return -2;
     }
-
-    // 运行中，异步销毁
-    case E_HS_TIMER_STATUS_RUNNING:
+    memcpy(&header, buf, sizeof(header));
+    if ((header.magic != HS_TIMER_SNAPSHOT_MAGIC) || (header.version != HS_TIMER_SNAPSHOT_VERSION) ||
+        (header.record_size != sizeof(hs_timer_snapshot_record_t)) ||
+        (header.count > ((length - sizeof(header)) / sizeof(hs_timer_snapshot_record_t))))
     {
-        hs_timer->status = E_HS_TIMER_STATUS_REQUEST_DESTROY;
-        pthread_mutex_unlock(&hs_timer->mutex);
-
-        return 0;
+        return -2;
     }
 
-    // 暂停中，立即销毁
-    case E_HS_TIMER_STATUS_PAUSED:
+    if ((header.count > capacity) || (header.count > INT32_MAX))
     {
-        timer_delete(hs_timer->timer_id);
-        pthread_mutex_unlock(&hs_timer->mutex);
-        pthread_mutex_destroy(&hs_timer->mutex);
-        free(hs_timer);
-
-        return 0;
+        return -3;
     }
 
-    // 销毁中，忽略
-    case E_HS_TIMER_STATUS_REQUEST_DESTROY:
+    // 先全部分配，失败时还没有定时器交给引擎，可以直接全部销毁
+    size_t count = (size_t)header.count;
+    for (size_t i = 0; i < count; i++)
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        timers[i] = hs_timer_engine_alloc_timer(engine, NULL);
+        if (timers[i] == NULL)
+        {
+            hs_timer_destroy_batch(timers, i);
 
-        return 0;
+            return -4;
+        }
+
+        hs_timer_setup(timers[i], engine);
     }
 
-    default:
+    // 定时器已处于 E_HS_TIMER_STATUS_CREATED，遍历等可能同时读取，参数与 hs_timer_init_ns() 一样原子写入；
+    // 运行中的定时器共用一次时钟读取，一次批量提交
+    hs_timer_engine_batch_t batch;
+    hs_timer_engine_batch_init(&batch);
+
+    const uint8_t *records = (const uint8_t *)buf + sizeof(header);
+    uint64_t now_ns = hs_timer_engine_now_ns(engine);
+    for (size_t i = 0; i < count; i++)
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        hs_timer_snapshot_record_t record;
+        memcpy(&record, records + (i * sizeof(record)), sizeof(record));
+
+        hs_timer_t *hs_timer = timers[i];
+        __atomic_store_n(&hs_timer->timer_cb, record.timer_cb, __ATOMIC_RELEASE);
+        __atomic_store_n(&hs_timer->repeat_count, record.repeat_count, __ATOMIC_RELAXED);
+        __atomic_store_n(&hs_timer->timeout_ns, record.timeout_ns, __ATOMIC_RELAXED);
+        __atomic_store_n(&hs_timer->user_data, record.user_data, __ATOMIC_RELEASE);
+        if (record.periodic_mode <= E_HS_TIMER_PERIODIC_COALESCE)
+        {
+            __atomic_store_n(&hs_timer->periodic_mode, (hs_timer_periodic_mode_e)record.periodic_mode,
+                             __ATOMIC_RELAXED);
+        }
+        if (record.priority <= E_HS_TIMER_PRIORITY_HIGH)
+        {
+            __atomic_store_n(&hs_timer->priority, (hs_timer_priority_e)record.priority, __ATOMIC_RELAXED);
+        }
 
-        return -2;
-    }
+        if (record.state == E_HS_TIMER_STATE_RUNNING)
+        {
+            uint64_t remaining_ns = record.remaining_ns;
+            hs_timer_store_deadline(
+                hs_timer, (remaining_ns > (UINT64_MAX - now_ns)) ? UINT64_MAX : (now_ns + remaining_ns), 0);
+            __atomic_store_n(&hs_timer->status, E_HS_TIMER_STATUS_RUNNING, __ATOMIC_RELEASE);
+            hs_timer_trace_transition(hs_timer, E_HS_TIMER_STATUS_CREATED, E_HS_TIMER_STATUS_RUNNING);
+            hs_timer_engine_batch_add(&batch, hs_timer);
+        }
+        else if (record.state == E_HS_TIMER_STATE_PAUSED)
+        {
+            __atomic_store_n(&hs_timer->status, E_HS_TIMER_STATUS_PAUSED, __ATOMIC_RELEASE);
+            hs_timer_trace_transition(hs_timer, E_HS_TIMER_STATUS_CREATED, E_HS_TIMER_STATUS_PAUSED);
+        }
     }
+    hs_timer_engine_batch_commit(&batch);
+
+    return (int)count;
 }
 
-int hs_timer_set_cb(hs_timer_t *hs_timer, const hs_timer_cb timer_cb)
+int hs_timer_set_user_data(hs_timer_t *hs_timer, const void *user_data)
 {
     if (hs_timer == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
     if (!hs_timer_can_set_params(hs_timer))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -2;
     }
 
-    hs_timer->timer_cb = timer_cb;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    __atomic_store_n(&hs_timer->user_data, user_data, __ATOMIC_RELEASE);
 
     return 0;
 }
 
-int hs_timer_set_repeat_count(hs_timer_t *hs_timer, const uint32_t repeat_count)
+int hs_timer_set_release_cb(hs_timer_t *hs_timer, const hs_timer_release_cb release_cb)
 {
     if (hs_timer == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
     if (!hs_timer_can_set_params(hs_timer))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -2;
     }
 
-    hs_timer->repeat_count = repeat_count;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    __atomic_store_n(&hs_timer->release_cb, release_cb, __ATOMIC_RELEASE);
 
     return 0;
 }
 
-int hs_timer_set_timeout(hs_timer_t *hs_timer, const uint32_t timeout_ms)
+int hs_timer_set_periodic_mode(hs_timer_t *hs_timer, const hs_timer_periodic_mode_e periodic_mode)
 {
     if (hs_timer == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    if (!hs_timer_can_set_params(hs_timer))
+    if ((periodic_mode < E_HS_TIMER_PERIODIC_RELATIVE) || (periodic_mode > E_HS_TIMER_PERIODIC_COALESCE))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -2;
     }
 
-    struct itimerspec timer_spec = {0};
-    if (hs_timer_ms_to_timespec_one_shot(timeout_ms, &timer_spec) != 0)
+    if (!hs_timer_can_set_params(hs_timer))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -3;
     }
 
-    if (timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL) == -1)
+    __atomic_store_n(&hs_timer->periodic_mode, periodic_mode, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int hs_timer_set_priority(hs_timer_t *hs_timer, const hs_timer_priority_e priority)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
+    }
+
+    if ((priority < E_HS_TIMER_PRIORITY_NORMAL) || (priority > E_HS_TIMER_PRIORITY_HIGH))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        return -2;
+    }
 
-        return -4;
+    if (!hs_timer_can_set_params(hs_timer))
+    {
+        return -3;
     }
 
-    hs_timer->timeout_ms = timeout_ms;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    __atomic_store_n(&hs_timer->priority, priority, __ATOMIC_RELAXED);
 
     return 0;
 }
 
-int hs_timer_set_user_data(hs_timer_t *hs_timer, const void *user_data)
+int hs_timer_set_slack_ns(hs_timer_t *hs_timer, const uint64_t slack_ns)
 {
     if (hs_timer == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
     if (!hs_timer_can_set_params(hs_timer))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -2;
     }
 
-    hs_timer->user_data = user_data;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    // 下一次启动时生效
+    __atomic_store_n(&hs_timer->slack_ns, slack_ns, __ATOMIC_RELAXED);
 
     return 0;
 }
@@ -402,138 +1578,256 @@ int hs_timer_get_repeat_count(hs_timer_t *hs_timer, uint32_t *repeat_count)
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    *repeat_count = hs_timer->repeat_count;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    *repeat_count = __atomic_load_n(&hs_timer->repeat_count, __ATOMIC_RELAXED);
 
     return 0;
 }
 
 int hs_timer_get_timeout(hs_timer_t *hs_timer, uint32_t *timeout_ms)
 {
-    if (hs_timer == NULL)
+    if (timeout_ms == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    *timeout_ms = hs_timer->timeout_ms;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    uint64_t timeout_ns = 0;
+    int ret = hs_timer_get_timeout_ns(hs_timer, &timeout_ns);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    uint64_t value = timeout_ns / HS_TIMER_NSEC_PER_MSEC;
+    *timeout_ms = (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
 
     return 0;
 }
 
-const void *hs_timer_get_user_data(hs_timer_t *hs_timer)
+int hs_timer_get_timeout_ns(hs_timer_t *hs_timer, uint64_t *timeout_ns)
 {
-    if (hs_timer == NULL)
+    if ((hs_timer == NULL) || (timeout_ns == NULL))
     {
-        return NULL;
+        return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    const void *user_data = hs_timer->user_data;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    *timeout_ns = __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_RELAXED);
 
-    return user_data;
+    return 0;
 }
 
-int hs_timer_ready(hs_timer_t *hs_timer)
+int hs_timer_get_overrun(hs_timer_t *hs_timer, uint32_t *overrun)
 {
-    if (hs_timer == NULL)
+    if ((hs_timer == NULL) || (overrun == NULL))
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    if ((hs_timer->status != E_HS_TIMER_STATUS_RUNNING) && (hs_timer->status != E_HS_TIMER_STATUS_PAUSED))
-    {
-        pthread_mutex_unlock(&hs_timer->mutex);
+    *overrun = __atomic_load_n(&hs_timer->overrun, __ATOMIC_RELAXED);
 
-        return -2;
+    return 0;
+}
+
+int hs_timer_get_slack_ns(hs_timer_t *hs_timer, uint64_t *slack_ns)
+{
+    if ((hs_timer == NULL) || (slack_ns == NULL))
+    {
+        return -1;
     }
 
-    // 因为使用 one-shot 模式，这里不设置 it_interval。在回调函数中，根据 repeat_count 决定是否再次启动
-    struct itimerspec timer_spec = {0};
-    timer_spec.it_interval.tv_sec = 0;
-    timer_spec.it_interval.tv_nsec = 0;
-    timer_spec.it_value.tv_sec = 0;
-    timer_spec.it_value.tv_nsec = 1;
-    if (timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL) == -1)
+    *slack_ns = __atomic_load_n(&hs_timer->slack_ns, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/**
+ * @brief 读取运行中定时器的到期时间
+ *
+ * @note 启动序号在读取期间变化 (定时器被重新启动) 时重新读取
+ *
+ * @param[in]  hs_timer   : 定时器对象
+ * @param[out] deadline_ns: 到期时间 (定时器时钟, 单位: ns)
+ *
+ * @return true : 成功
+ * @return false: 定时器未在运行
+ */
+static bool hs_timer_load_deadline(const hs_timer_t *hs_timer, uint64_t *deadline_ns)
+{
+    uint32_t arm_seq = 0;
+    do
+    {
+        arm_seq = __atomic_load_n(&hs_timer->arm_seq, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE) != E_HS_TIMER_STATUS_RUNNING)
+        {
+            return false;
+        }
+        *deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&hs_timer->arm_seq, __ATOMIC_RELAXED) != arm_seq);
+
+    return true;
+}
+
+int hs_timer_get_remaining_ns(hs_timer_t *hs_timer, uint64_t *remaining_ns)
+{
+    if ((hs_timer == NULL) || (remaining_ns == NULL))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        return -1;
+    }
 
-        return -3;
+    uint64_t deadline_ns = 0;
+    if (!hs_timer_load_deadline(hs_timer, &deadline_ns))
+    {
+        return -2;
     }
 
-    hs_timer->status = E_HS_TIMER_STATUS_RUNNING;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    uint64_t now_ns = hs_timer_now_ns(hs_timer);
+    *remaining_ns = (deadline_ns > now_ns) ? (deadline_ns - now_ns) : 0;
 
     return 0;
 }
 
-int hs_timer_pause(hs_timer_t *hs_timer)
+int hs_timer_get_next_deadline(hs_timer_t *hs_timer, uint64_t *deadline_ns)
 {
-    if (hs_timer == NULL)
+    if ((hs_timer == NULL) || (deadline_ns == NULL))
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    if ((hs_timer->status != E_HS_TIMER_STATUS_RUNNING) && (hs_timer->status != E_HS_TIMER_STATUS_PAUSED))
+    uint64_t timer_deadline_ns = 0;
+    if (!hs_timer_load_deadline(hs_timer, &timer_deadline_ns))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
-
         return -2;
     }
 
-    struct itimerspec timer_spec = {0};
-    if (timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL) == -1)
-    {
-        pthread_mutex_unlock(&hs_timer->mutex);
+    // 分组成员的到期时间按当前分组时钟换算为引擎时间
+    uint64_t wake_ns = hs_timer_wake_ns(hs_timer, timer_deadline_ns);
+    *deadline_ns = (wake_ns == HS_TIMER_ENGINE_WAKE_NONE) ? UINT64_MAX : wake_ns;
 
-        return -3;
+    return 0;
+}
+
+int hs_timer_get_stats(hs_timer_t *hs_timer, hs_timer_stats_t *stats)
+{
+    if ((hs_timer == NULL) || (stats == NULL))
+    {
+        return -1;
     }
 
-    hs_timer->status = E_HS_TIMER_STATUS_PAUSED;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    const hs_timer_stats_t *src = &hs_timer->stats;
+    stats->expired_count = __atomic_load_n(&src->expired_count, __ATOMIC_RELAXED);
+    stats->overrun_count = __atomic_load_n(&src->overrun_count, __ATOMIC_RELAXED);
+    stats->last_lateness_ns = __atomic_load_n(&src->last_lateness_ns, __ATOMIC_RELAXED);
+    stats->max_lateness_ns = __atomic_load_n(&src->max_lateness_ns, __ATOMIC_RELAXED);
+    stats->last_callback_ns = __atomic_load_n(&src->last_callback_ns, __ATOMIC_RELAXED);
+    stats->max_callback_ns = __atomic_load_n(&src->max_callback_ns, __ATOMIC_RELAXED);
 
     return 0;
 }
 
-int hs_timer_resume(hs_timer_t *hs_timer)
+const void *hs_timer_get_user_data(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    return __atomic_load_n(&hs_timer->user_data, __ATOMIC_ACQUIRE);
+}
+
+void *hs_timer_get_inline_data(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    return hs_timer->inline_data.data;
+}
+
+int hs_timer_ready(hs_timer_t *hs_timer)
 {
     if (hs_timer == NULL)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    if (hs_timer->status != E_HS_TIMER_STATUS_PAUSED)
+    hs_timer_engine_enter(hs_timer);
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    bool ret = hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_RUNNING, NULL);
+    if (ret)
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        // 立即到期，绝对周期从当前时间重新开始计算
+        hs_timer_arm(hs_timer, 0);
+    }
+    hs_timer_engine_leave(hs_timer);
 
-        return -2;
+    return ret ? 0 : -2;
+}
+
+int hs_timer_pause(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
     }
 
-    struct itimerspec timer_spec = {0};
-    if (hs_timer_ms_to_timespec_one_shot(hs_timer->timeout_ms, &timer_spec) != 0)
+    hs_timer_engine_enter(hs_timer);
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    hs_timer_status_e status = E_HS_TIMER_STATUS_UNUSED;
+    bool ret = hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_PAUSED, &status);
+
+    // 不需要唤醒引擎，暂停后即使先到期也不会执行回调
+    if (ret && (status == E_HS_TIMER_STATUS_RUNNING))
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        hs_timer_engine_submit(hs_timer->engine, hs_timer, HS_TIMER_ENGINE_WAKE_NONE);
+    }
+    hs_timer_engine_leave(hs_timer);
 
-        return -3;
+    return ret ? 0 : -2;
+}
+
+int hs_timer_resume(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
     }
 
-    if (timer_settime(hs_timer->timer_id, 0, &timer_spec, NULL) == -1)
+    hs_timer_engine_enter(hs_timer);
+    bool ret = hs_timer_transition(hs_timer, HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED), E_HS_TIMER_STATUS_RUNNING,
+                                   NULL);
+    if (ret)
     {
-        pthread_mutex_unlock(&hs_timer->mutex);
+        hs_timer_arm(hs_timer, __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_RELAXED));
+    }
+    hs_timer_engine_leave(hs_timer);
 
-        return -4;
+    return ret ? 0 : -2;
+}
+
+int hs_timer_cancel_lazy(hs_timer_t *hs_timer)
+{
+    if (hs_timer == NULL)
+    {
+        return -1;
     }
 
-    hs_timer->status = E_HS_TIMER_STATUS_RUNNING;
-    pthread_mutex_unlock(&hs_timer->mutex);
+    // 先标记再切换状态，派发方看到已暂停的定时器时一定能看到标记
+    hs_timer_engine_enter(hs_timer);
+    hs_timer_engine_t *engine = hs_timer->engine;
+    bool marked = hs_timer_engine_mark_tombstone(engine, hs_timer);
 
-    return 0;
+    uint32_t from_mask = HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_RUNNING) | HS_TIMER_STATUS_BIT(E_HS_TIMER_STATUS_PAUSED);
+    hs_timer_status_e status = E_HS_TIMER_STATUS_UNUSED;
+    bool ret = hs_timer_transition(hs_timer, from_mask, E_HS_TIMER_STATUS_PAUSED, &status);
+
+    // 原本就已暂停的定时器已经 (或即将) 从时间轮中移除，不会留下墓碑
+    if (marked && (!ret || (status == E_HS_TIMER_STATUS_PAUSED)))
+    {
+        hs_timer_engine_clear_tombstone(engine, hs_timer);
+    }
+    hs_timer_engine_leave(hs_timer);
+
+    return ret ? 0 : -2;
 }
 
 bool hs_timer_is_paused(hs_timer_t *hs_timer)
@@ -543,9 +1837,18 @@ bool hs_timer_is_paused(hs_timer_t *hs_timer)
         return false;
     }
 
-    pthread_mutex_lock(&hs_timer->mutex);
-    bool is_paused = (hs_timer->status == E_HS_TIMER_STATUS_PAUSED);
-    pthread_mutex_unlock(&hs_timer->mutex);
+    return (hs_timer_load_status(hs_timer) == E_HS_TIMER_STATUS_PAUSED);
+}
+
+int hs_timer_trace_set_cb(const hs_timer_trace_cb trace_cb)
+{
+#ifdef HS_TIMER_ENABLE_TRACE
+    __atomic_store_n(&g_hs_timer_trace_cb, trace_cb, __ATOMIC_RELEASE);
+
+    return 0;
+#else
+    (void)trace_cb;
 
-    return is_paused;
+    return -2;
+#endif
 }
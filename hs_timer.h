@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -23,9 +24,167 @@ extern "C"
 #define HS_TIMER_REPEAT_ONCE    (1U)         // 定时器执行一次
 #define HS_TIMER_REPEAT_FOREVER (UINT32_MAX) // 定时器无限循环
 
+#define HS_TIMER_ENGINE_DEFAULT_WORKER_COUNT (4U)       // 默认引擎的回调工作线程数
+#define HS_TIMER_ENGINE_DEFAULT_TICK_NS      (1000000ULL) // 默认引擎的节拍时长 (单位: ns)
+#define HS_TIMER_STORAGE_SIZE                (512U)       // 定时器对象占用的存储空间 (单位: 字节)
+#define HS_TIMER_ENGINE_CPU_ANY              (-1)         // 引擎线程不绑定 CPU
+#define HS_TIMER_ENGINE_HYBRID_TICKS         (4096U)      // 混合模式下放入堆的最小节拍数 (默认节拍下约 4 秒)
+#define HS_TIMER_HISTOGRAM_BUCKETS           (252U)       // 直方图桶数 (每个 2 的幂区间 4 个桶，覆盖全部 uint64_t)
+#define HS_TIMER_INLINE_DATA_SIZE            (64U)        // 定时器对象内嵌的用户数据区大小 (单位: 字节, 按 8 字节对齐)
+#define HS_TIMER_ENGINE_COMPACT_PERCENT      (25U)        // 默认的墓碑压缩阈值 (占等待到期定时器的百分比)
+#define HS_TIMER_ENGINE_COMPACT_MIN          (64U)        // 触发压缩的最少墓碑数量
+#define HS_TIMER_SNAPSHOT_MAGIC              (0x48535453) // 序列化快照的标识 ("HSTS")
+#define HS_TIMER_SNAPSHOT_VERSION            (1U)         // 序列化快照的格式版本
+#define HS_TIMER_GROUP_BATCH_STACK           (64U)        // 批量回调不申请内存时的最大定时器数量
+
 // 定时器对象
 typedef struct _hs_timer hs_timer_t;
 
+// 定时器引擎
+typedef struct _hs_timer_engine hs_timer_engine_t;
+
+// 定时器分组
+typedef struct _hs_timer_group hs_timer_group_t;
+
+// 定时器对象的静态存储空间
+typedef union hs_timer_storage
+{
+    uint8_t data[HS_TIMER_STORAGE_SIZE]; // 存储空间
+    uint64_t align_u64;                  // 对齐
+    void *align_ptr;                     // 对齐
+} hs_timer_storage_t;
+
+// 周期定时器调度策略
+typedef enum hs_timer_periodic_mode
+{
+    E_HS_TIMER_PERIODIC_RELATIVE = 0, // 回调结束后按超时时间重新计时 (回调耗时和调度延迟会累积为漂移)
+    E_HS_TIMER_PERIODIC_SKIP,         // 按起始时间计算绝对到期时间，错过的周期直接跳过
+    E_HS_TIMER_PERIODIC_CATCH_UP,     // 按起始时间计算绝对到期时间，错过的周期逐个补执行
+    E_HS_TIMER_PERIODIC_COALESCE,     // 按起始时间计算绝对到期时间，错过的周期合并为一次立即执行
+} hs_timer_periodic_mode_e;
+
+// 定时器优先级
+typedef enum hs_timer_priority
+{
+    E_HS_TIMER_PRIORITY_NORMAL = 0, // 普通
+    E_HS_TIMER_PRIORITY_HIGH,       // 高 (同一次唤醒中先于普通定时器派发，不受派发预算限制)
+} hs_timer_priority_e;
+
+// 定时器状态 (用于查看)
+typedef enum hs_timer_state
+{
+    E_HS_TIMER_STATE_CREATED = 0, // 已创建，未启动
+    E_HS_TIMER_STATE_RUNNING,     // 运行中
+    E_HS_TIMER_STATE_PAUSED,      // 已暂停
+    E_HS_TIMER_STATE_DESTROYING,  // 已请求销毁，等待引擎回收
+} hs_timer_state_e;
+
+// 定时器引擎运行模式
+typedef enum hs_timer_engine_mode
+{
+    E_HS_TIMER_ENGINE_MODE_THREAD = 0, // 引擎自带派发线程和回调工作线程
+    E_HS_TIMER_ENGINE_MODE_EXTERNAL,   // 不创建任何线程，由用户的事件循环驱动
+} hs_timer_engine_mode_e;
+
+// 定时器引擎的到期时间管理方式
+typedef enum hs_timer_engine_backend
+{
+    E_HS_TIMER_ENGINE_BACKEND_WHEEL = 0, // 分层时间轮 (启动/停止 O(1)，适合大量较短的超时)
+    E_HS_TIMER_ENGINE_BACKEND_HEAP,      // 四叉最小堆 (启动/停止 O(log n)，适合少量数小时以上的长超时)
+    E_HS_TIMER_ENGINE_BACKEND_HYBRID,    // 较短的超时放入时间轮，较长的超时放入堆，长超时不需要逐层级联
+} hs_timer_engine_backend_e;
+
+// 定时器引擎的时钟
+typedef enum hs_timer_engine_clock
+{
+    E_HS_TIMER_ENGINE_CLOCK_MONOTONIC = 0, // CLOCK_MONOTONIC (vDSO 读取，精度高)
+    E_HS_TIMER_ENGINE_CLOCK_COARSE,        // CLOCK_MONOTONIC_COARSE (读取最快，精度为内核节拍，适合粗粒度超时)
+    E_HS_TIMER_ENGINE_CLOCK_BOOTTIME,      // CLOCK_BOOTTIME (包括系统休眠的时间，休眠期间到期的定时器唤醒后立即到期)
+    E_HS_TIMER_ENGINE_CLOCK_TSC,           // 校准到 CLOCK_MONOTONIC 的处理器计数器 (不经过 vDSO，需要恒定频率的 TSC)
+} hs_timer_engine_clock_e;
+
+/**
+ * @brief 执行器任务函数
+ *
+ * @param[in,out] arg: 任务参数
+ */
+typedef void (*hs_timer_task_fn)(void *arg);
+
+/**
+ * @brief 执行器提交函数
+ *
+ * @note 1. 由引擎的派发方调用，只应把任务放入执行器的队列后尽快返回
+ *       2. 提交成功的任务必须且只能执行一次，可以在任意线程执行
+ *
+ * @param[in]     task        : 任务函数
+ * @param[in,out] arg         : 任务参数
+ * @param[in,out] executor_ctx: 引擎配置中的 executor_ctx
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (引擎在派发方直接执行该任务)
+ */
+typedef int (*hs_timer_executor_submit_cb)(hs_timer_task_fn task, void *arg, void *executor_ctx);
+
+// 定时器引擎配置
+typedef struct hs_timer_engine_config
+{
+    hs_timer_engine_mode_e mode;                 // 运行模式
+    uint32_t worker_count;                       // 回调工作线程数 (0: 回调在派发线程中执行; 外部驱动模式下忽略)
+    uint64_t tick_ns;                            // 节拍时长, 即定时精度 (单位: ns; 0: HS_TIMER_ENGINE_DEFAULT_TICK_NS)
+    uint64_t slack_ns;                           // 新建定时器默认允许延后到期的时间 (单位: ns)
+    int32_t cpu;                                 // 派发线程和回调工作线程绑定的 CPU (HS_TIMER_ENGINE_CPU_ANY: 不绑定)
+    hs_timer_engine_backend_e backend;           // 到期时间管理方式
+    hs_timer_executor_submit_cb executor_submit; // 回调执行器 (NULL: 使用引擎自己的线程; 非 NULL 时忽略 worker_count)
+    void *executor_ctx;                          // 传给 executor_submit 的用户参数
+    uint32_t dispatch_budget;                    // 每次唤醒最多派发的回调数 (0: 不限制)
+    uint64_t dispatch_budget_ns;                 // 每次唤醒派发回调的时间预算 (单位: ns; 0: 不限制)
+    uint32_t high_worker_count;                  // 高优先级回调工作线程数 (0: 与普通定时器共用回调线程)
+    int32_t high_worker_policy;                  // 高优先级回调工作线程的调度策略 (如 SCHED_FIFO; 0: 不修改)
+    int32_t high_worker_sched_priority;          // 高优先级回调工作线程的调度优先级 (仅实时调度策略有效)
+    uint32_t compact_percent;                    // 墓碑占等待到期定时器的百分比达到该值时压缩时间轮和堆 (0: 不压缩)
+    hs_timer_engine_clock_e clock;               // 引擎时钟 (定时器的到期时间、统计中的延迟和耗时都按该时钟计算)
+    uint64_t spin_ns;                            // 派发线程到期前自旋等待的时间 (单位: ns; 0: 一直睡眠到期; 仅自带线程模式)
+} hs_timer_engine_config_t;
+
+// 时间直方图 (对数线性分桶，桶宽不超过桶下界的 25%)
+typedef struct hs_timer_histogram
+{
+    uint64_t count;                               // 样本数
+    uint64_t sum_ns;                              // 样本总和 (单位: ns)
+    uint64_t max_ns;                              // 最大值 (单位: ns)
+    uint64_t buckets[HS_TIMER_HISTOGRAM_BUCKETS]; // 各桶的样本数
+} hs_timer_histogram_t;
+
+// 定时器统计 (计数只增不减)
+typedef struct hs_timer_stats
+{
+    uint64_t expired_count;    // 回调执行次数
+    uint64_t overrun_count;    // 合并或跳过的周期总数
+    uint64_t last_lateness_ns; // 最近一次回调开始时间相对到期时间的延迟 (单位: ns)
+    uint64_t max_lateness_ns;  // 回调开始时间相对到期时间的最大延迟 (单位: ns)
+    uint64_t last_callback_ns; // 最近一次回调耗时 (单位: ns)
+    uint64_t max_callback_ns;  // 最大回调耗时 (单位: ns)
+} hs_timer_stats_t;
+
+// 定时器引擎统计 (计数只增不减，两次读取的差值即为期间的增量)
+typedef struct hs_timer_engine_stats
+{
+    uint64_t timer_count;          // 定时器数量 (包括未启动和暂停的)
+    uint64_t active_count;         // 等待到期的定时器数量 (时间轮和堆之和，派发方每轮处理结束时更新)
+    uint64_t deferred_count;       // 已到期、因超出派发预算顺延到之后派发的定时器数量
+    uint64_t tombstone_count;      // 延迟取消后仍留在时间轮和堆中的定时器数量 (除以 active_count 即为墓碑占比)
+    uint64_t tombstone_dropped;    // 派发方到达时直接丢弃的墓碑数量
+    uint64_t compact_count;        // 压缩次数
+    uint64_t compacted_count;      // 压缩时移除的墓碑数量
+    uint64_t wakeup_count;         // 派发方处理次数
+    uint64_t spin_count;           // 派发线程提前醒来自旋等待的次数
+    uint64_t spin_ns;              // 派发线程自旋占用的 CPU 时间 (单位: ns)
+    uint64_t expired_count;        // 回调执行次数
+    uint64_t overrun_count;        // 合并或跳过的周期总数
+    hs_timer_histogram_t lateness; // 回调开始时间相对到期时间的延迟
+    hs_timer_histogram_t callback; // 回调耗时
+} hs_timer_engine_stats_t;
+
 /**
  * @brief 定时器回调函数
  *
@@ -33,14 +192,440 @@ typedef struct _hs_timer hs_timer_t;
  */
 typedef void (*hs_timer_cb)(hs_timer_t *hs_timer);
 
+// 定时器快照 (hs_timer_engine_foreach() 读取时的状态)
+typedef struct hs_timer_info
+{
+    const hs_timer_t *hs_timer;             // 定时器对象 (只用于标识，遍历回调返回后可能已被回收)
+    hs_timer_state_e state;                 // 状态
+    hs_timer_cb timer_cb;                   // 回调函数地址
+    const void *user_data;                  // 用户数据
+    uint64_t timeout_ns;                    // 超时时间 (单位: ns)
+    uint64_t remaining_ns;                  // 距离到期的时间 (单位: ns; 仅运行中有效，已到期为 0)
+    uint32_t repeat_count;                  // 剩余重复次数 (UINT32_MAX: 无限循环)
+    hs_timer_periodic_mode_e periodic_mode; // 周期调度策略
+    hs_timer_priority_e priority;           // 优先级
+    bool is_static;                         // 是否使用用户提供的存储空间
+} hs_timer_info_t;
+
+/**
+ * @brief 定时器遍历回调函数
+ *
+ * @param[in]     info: 定时器快照
+ * @param[in,out] arg : 用户参数
+ *
+ * @return 0    : 继续遍历
+ * @return 非 0 : 停止遍历
+ */
+typedef int (*hs_timer_foreach_cb)(const hs_timer_info_t *info, void *arg);
+
+/**
+ * @brief 分组批量回调函数
+ *
+ * @note expired 数组只在回调期间有效，不能修改数组本身；可以操作其中的定时器 (与单独回调中相同)
+ *
+ * @param[in,out] expired: 本轮一起到期的成员定时器
+ * @param[in]     count  : 定时器数量
+ * @param[in,out] ctx    : 创建分组时传入的用户参数
+ */
+typedef void (*hs_timer_group_cb)(hs_timer_t **expired, size_t count, void *ctx);
+
+// 跟踪事件
+typedef enum hs_timer_trace_event
+{
+    E_HS_TIMER_TRACE_CREATE = 0,     // 创建定时器 (arg: 0)
+    E_HS_TIMER_TRACE_START,          // 进入运行中 (arg: 切换前的状态 hs_timer_state_e)
+    E_HS_TIMER_TRACE_PAUSE,          // 进入已暂停 (arg: 切换前的状态 hs_timer_state_e)
+    E_HS_TIMER_TRACE_DESTROY,        // 请求销毁 (arg: 切换前的状态 hs_timer_state_e)
+    E_HS_TIMER_TRACE_RELEASE,        // 引擎回收定时器 (arg: 0)
+    E_HS_TIMER_TRACE_DISPATCH,       // 派发方取出到期的定时器 (arg: 到期时间，单位: ns)
+    E_HS_TIMER_TRACE_CALLBACK_BEGIN, // 回调开始 (arg: 延迟，单位: ns; 批量回调时为成员数量)
+    E_HS_TIMER_TRACE_CALLBACK_END,   // 回调结束 (arg: 回调耗时，单位: ns)
+} hs_timer_trace_event_e;
+
+/**
+ * @brief 跟踪回调函数
+ *
+ * @note 1. 在触发事件的线程中同步调用，可能同时在多个线程中调用，应尽快返回
+ *       2. 不能在跟踪回调中操作定时器或引擎
+ *       3. 批量回调的 CALLBACK_BEGIN/CALLBACK_END 只对首个成员调用一次
+ *
+ * @param[in] event   : 跟踪事件
+ * @param[in] hs_timer: 定时器对象 (只用于标识)
+ * @param[in] arg     : 事件参数 (见 hs_timer_trace_event_e)
+ */
+typedef void (*hs_timer_trace_cb)(hs_timer_trace_event_e event, const hs_timer_t *hs_timer, uint64_t arg);
+
+// 序列化快照头 (hs_timer_engine_serialize() 输出的开头，之后紧跟 count 条记录)
+typedef struct hs_timer_snapshot_header
+{
+    uint32_t magic;       // 标识 (HS_TIMER_SNAPSHOT_MAGIC)
+    uint16_t version;     // 格式版本 (HS_TIMER_SNAPSHOT_VERSION)
+    uint16_t record_size; // 每条记录的大小 (单位: 字节)
+    uint64_t count;       // 记录数量
+} hs_timer_snapshot_header_t;
+
+// 序列化快照记录 (一个定时器)
+typedef struct hs_timer_snapshot_record
+{
+    uint64_t remaining_ns; // 距离到期的时间 (单位: ns; 仅运行中有效)
+    uint64_t timeout_ns;   // 超时时间 (单位: ns)
+    hs_timer_cb timer_cb;  // 回调函数地址 (只在同一程序映像中有效，如 fork() 后的子进程)
+    const void *user_data; // 用户数据 (同上)
+    uint32_t repeat_count; // 剩余重复次数 (UINT32_MAX: 无限循环)
+    uint8_t state;         // 状态 (hs_timer_state_e, 不含 E_HS_TIMER_STATE_DESTROYING)
+    uint8_t periodic_mode; // 周期调度策略 (hs_timer_periodic_mode_e)
+    uint8_t priority;      // 优先级 (hs_timer_priority_e)
+    uint8_t reserved;      // 保留 (写入 0)
+} hs_timer_snapshot_record_t;
+
+/**
+ * @brief 定时器释放回调函数
+ *
+ * @note 定时器对象被引擎回收前调用，此时回调函数已结束且不会再执行
+ *
+ * @param[in,out] hs_timer: 定时器对象 (只能访问内嵌数据区和用户数据)
+ */
+typedef void (*hs_timer_release_cb)(hs_timer_t *hs_timer);
+
+/**
+ * @brief 初始化引擎配置为默认值
+ *
+ * @param[out] config: 引擎配置
+ */
+void hs_timer_engine_config_init(hs_timer_engine_config_t *config);
+
+/**
+ * @brief 创建定时器引擎
+ *
+ * @note 1. 每个引擎拥有一个时间轮 (或堆)、一个派发线程和 worker_count 个常驻回调工作线程
+ *       2. 同一定时器的回调不会并发执行，不同定时器的回调可能在不同工作线程中并发执行
+ *       3. config->cpu 超出范围或对应 CPU 不可用时创建失败
+ *       4. 配置了 executor_submit 时，引擎只计算到期，每次到期作为一个任务提交给执行器，
+ *          同一定时器的上一个任务结束前不会提交下一个任务
+ *       5. E_HS_TIMER_ENGINE_BACKEND_HYBRID 模式下，到期节拍在 HS_TIMER_ENGINE_HYBRID_TICKS 个节拍之后的定时器放入堆；
+ *          默认引擎和分片引擎使用时间轮
+ *       6. 设置 dispatch_budget 或 dispatch_budget_ns 后，到期的定时器严格按到期时间先后派发，每次唤醒派发的数量或
+ *          耗时超出预算时，剩余的定时器顺延到下一个节拍继续派发 (每次唤醒至少派发一个)；时间预算包括在派发方
+ *          执行的回调耗时，回调交给其它线程执行时只包括提交耗时
+ *       7. high_worker_count 不为 0 时，高优先级定时器的回调只在这些线程中执行，普通定时器的回调堆积不会延迟
+ *          高优先级回调；设置了 high_worker_policy 时没有权限 (如 SCHED_FIFO 需要 CAP_SYS_NICE) 则创建失败
+ *       8. hs_timer_cancel_lazy() 留下的墓碑数量达到等待到期定时器的 compact_percent% 时 (且不少于
+ *          HS_TIMER_ENGINE_COMPACT_MIN 个)，派发方在本轮处理结束前遍历时间轮和堆，一次移除全部墓碑
+ *       9. 引擎在 fork() 后的子进程中继续可用：fork() 前等待各引擎本轮处理结束，子进程中重新创建描述符和引擎线程，
+ *          定时器的到期时间保持不变；执行到一半的回调在子进程中按已结束处理，提交给执行器未返回的任务不会再结束；
+ *          在定时器回调中调用 fork() 时子进程中的引擎不可用
+ *       10. E_HS_TIMER_ENGINE_CLOCK_TSC 在第一个使用它的引擎创建时校准一次 (约 10ms)，处理器不支持恒定频率的 TSC
+ *           或编译器不支持 128 位整数 (32 位目标) 时创建失败；E_HS_TIMER_ENGINE_CLOCK_COARSE 的定时器可能晚两到三个内核节拍 (clock_getres()) 到期
+ *       11. spin_ns 不为 0 时，派发线程睡眠到下一次到期前 spin_ns，之后在 CPU 上自旋读取时钟直到到期，省去内核唤醒的
+ *           延迟；自旋期间有新命令时立即处理。自旋会占满派发线程所在的 CPU，建议同时用 cpu 绑定到隔离的 CPU，
+ *           并使用 E_HS_TIMER_ENGINE_CLOCK_TSC 降低读取时钟的开销
+ *
+ * @param[in] config: 引擎配置 (NULL: 使用默认配置)
+ *
+ * @return 成功: 定时器引擎
+ * @return 失败: NULL
+ */
+hs_timer_engine_t *hs_timer_engine_create(const hs_timer_engine_config_t *config);
+
+/**
+ * @brief 销毁定时器引擎
+ *
+ * @note 1. 调用前必须销毁该引擎上的所有定时器
+ *       2. 默认引擎和分片引擎不能销毁
+ *       3. 不能在该引擎的回调函数中调用
+ *       4. 配置了 executor_submit 时，提交给执行器的任务还没有全部返回则返回失败 (不销毁)，
+ *          需要在执行器处理完这些任务后重试
+ *
+ * @param[in,out] engine: 定时器引擎
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_engine_destroy(hs_timer_engine_t *engine);
+
+/**
+ * @brief 获取引擎的可读事件描述符
+ *
+ * @note 1. 仅外部驱动模式可用
+ *       2. 描述符可加入 epoll/poll，可读时调用 hs_timer_engine_process_expired()
+ *       3. 描述符由引擎持有，用户不能读写或关闭
+ *
+ * @param[in] engine: 定时器引擎
+ *
+ * @return >=0: 文件描述符
+ * @return <0 : 失败
+ */
+int hs_timer_engine_get_fd(const hs_timer_engine_t *engine);
+
+/**
+ * @brief 处理引擎中已到期的定时器
+ *
+ * @note 1. 仅外部驱动模式可用
+ *       2. 到期定时器的回调直接在调用线程中执行
+ *       3. 同一引擎同一时刻只能有一个线程调用该函数
+ *       4. 不能在该引擎的回调函数中调用
+ *
+ * @param[in,out] engine: 定时器引擎
+ *
+ * @return >=0: 本次处理的定时器数量
+ * @return <0 : 失败
+ */
+int hs_timer_engine_process_expired(hs_timer_engine_t *engine);
+
+/**
+ * @brief 获取引擎时钟的当前时间
+ *
+ * @note 与 hs_timer_get_next_deadline() 的返回值使用同一时钟，可以直接比较
+ *
+ * @param[in] engine: 定时器引擎 (NULL: 默认引擎的时钟，即 CLOCK_MONOTONIC)
+ *
+ * @return 当前时间 (单位: ns)
+ */
+uint64_t hs_timer_engine_now_ns(const hs_timer_engine_t *engine);
+
+/**
+ * @brief 获取引擎统计
+ *
+ * @note 1. 统计由各回调执行线程分别记录，读取时汇总，记录和读取都不加锁
+ *       2. 延迟以定时器到期时间为基准，包括 slack_ns 允许的延后
+ *       3. 结构体较大 (约 4KB)，频繁读取时可以复用同一个结构体
+ *
+ * @param[in]  engine: 定时器引擎
+ * @param[out] stats : 引擎统计
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_engine_get_stats(hs_timer_engine_t *engine, hs_timer_engine_stats_t *stats);
+
+/**
+ * @brief 遍历引擎上的所有定时器
+ *
+ * @note 1. 对象池中的定时器无锁读取，不影响派发；用户存储空间上的定时器在对象池互斥锁内复制快照后再回调
+ *       2. 每个快照的各字段读取自同一个定时器，遍历期间创建或销毁的定时器可能包括也可能不包括在内
+ *       3. 回调中不持有任何锁，可以操作定时器，但 info->hs_timer 可能已被回收，不能直接使用
+ *
+ * @param[in]     engine    : 定时器引擎
+ * @param[in]     foreach_cb: 遍历回调函数
+ * @param[in,out] arg       : 传给 foreach_cb 的用户参数
+ *
+ * @return >=0: 回调的定时器数量
+ * @return <0 : 失败
+ */
+int hs_timer_engine_foreach(hs_timer_engine_t *engine, const hs_timer_foreach_cb foreach_cb, void *arg);
+
+/**
+ * @brief 将引擎上的所有定时器序列化为快照
+ *
+ * @note 1. 基于 hs_timer_engine_foreach()，不影响派发；已请求销毁的定时器不写入
+ *       2. 快照保存回调函数地址和用户数据指针，只能在同一程序映像中 (如 fork() 后的子进程) 还原
+ *       3. 内嵌数据区、释放回调函数、所属分组、统计信息和容差不写入
+ *
+ * @param[in]     engine: 定时器引擎
+ * @param[out]    buf   : 输出缓冲区 (为 NULL 时只计算所需大小)
+ * @param[in]     size  : 输出缓冲区大小 (单位: 字节)
+ * @param[out]    length: 快照大小 (缓冲区不足时为所需大小，单位: 字节)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (-3: 缓冲区不足)
+ */
+int hs_timer_engine_serialize(hs_timer_engine_t *engine, void *buf, const size_t size, size_t *length);
+
+/**
+ * @brief 从快照一次性重建定时器
+ *
+ * @note 1. 运行中的定时器按剩余时间从当前时间重新计时，所有定时器通过一次批量提交交给引擎
+ *       2. 已暂停的定时器保持暂停，可以用 hs_timer_resume() 重新启动；已创建的定时器需要再次初始化
+ *       3. 创建失败时已创建的定时器全部销毁
+ *
+ * @param[in]     engine  : 定时器引擎
+ * @param[in]     buf     : 快照 (hs_timer_engine_serialize() 的输出)
+ * @param[in]     length  : 快照大小 (单位: 字节)
+ * @param[out]    timers  : 重建的定时器对象 (与快照中的记录顺序相同)
+ * @param[in]     capacity: timers 的容量
+ *
+ * @return >=0: 重建的定时器数量
+ * @return <0 : 失败 (-2: 快照格式错误; -3: 容量不足)
+ */
+int hs_timer_engine_rehydrate(hs_timer_engine_t *engine, const void *buf, const size_t length, hs_timer_t **timers,
+                              const size_t capacity);
+
+/**
+ * @brief 获取直方图的百分位数
+ *
+ * @note 返回值为所在桶的上界 (不超过最大值)，误差不超过 25%
+ *
+ * @param[in] hist      : 直方图
+ * @param[in] percentile: 百分位 (0 ~ 100，例如 99.9)
+ *
+ * @return 百分位数 (单位: ns; 没有样本时为 0)
+ */
+uint64_t hs_timer_histogram_percentile(const hs_timer_histogram_t *hist, const double percentile);
+
+/**
+ * @brief 获取分片引擎数量
+ *
+ * @note 等于系统配置的 CPU 数量
+ *
+ * @return 分片引擎数量 (0: 失败)
+ */
+uint32_t hs_timer_engine_shard_count(void);
+
+/**
+ * @brief 获取指定 CPU 的分片引擎
+ *
+ * @note 1. 每个 CPU 一个分片引擎，首次获取时创建，之后一直存在，不能销毁
+ *       2. 分片引擎的派发线程绑定在对应 CPU 上，不创建回调工作线程，回调直接在该 CPU 上执行
+ *       3. 配合 hs_timer_create_on() 使用，定时器的启动、到期和回调都在同一个 CPU 上完成
+ *
+ * @param[in] cpu: CPU 编号 (小于 hs_timer_engine_shard_count())
+ *
+ * @return 成功: 分片引擎
+ * @return 失败: NULL (CPU 编号超出范围或不可用)
+ */
+hs_timer_engine_t *hs_timer_engine_shard(const uint32_t cpu);
+
+/**
+ * @brief 获取当前线程所在 CPU 的分片引擎
+ *
+ * @note 线程没有绑定 CPU 时，返回的是调用时刻所在 CPU 的分片引擎
+ *
+ * @return 成功: 分片引擎
+ * @return 失败: NULL
+ */
+hs_timer_engine_t *hs_timer_engine_shard_local(void);
+
 /**
  * @brief 创建定时器对象
  *
+ * @note 定时器对象属于默认引擎，默认引擎在首次调用时创建
+ *
  * @return 成功: 定时器对象
  * @return 失败: NULL
  */
 hs_timer_t *hs_timer_create(void);
 
+/**
+ * @brief 在指定引擎上创建定时器对象
+ *
+ * @param[in,out] engine: 定时器引擎
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL
+ */
+hs_timer_t *hs_timer_create_on(hs_timer_engine_t *engine);
+
+/**
+ * @brief 创建定时器分组
+ *
+ * @note 1. 设置了 batch_cb 时，派发方同一次处理中到期的成员只调用一次 batch_cb，不再调用成员各自的回调函数
+ *       2. 每个成员的重复次数、周期重启和统计照常处理，统计中的回调耗时为整次批量回调的耗时
+ *       3. 一次批量回调的定时器数量超过 HS_TIMER_GROUP_BATCH_STACK 时需要申请内存，申请失败时分多次回调
+ *       4. 同一分组的不同批量回调可能在不同回调工作线程中并发执行，与不同定时器的回调相同
+ *       5. 分组有自己的时钟，成员的超时时间按分组时间计算；分组时钟可以整体暂停、恢复、推迟，开销与成员数量无关
+ *
+ * @param[in,out] engine  : 定时器引擎 (NULL: 默认引擎)
+ * @param[in]     batch_cb: 批量回调函数 (NULL: 成员按各自的回调函数执行)
+ * @param[in,out] ctx     : 传给 batch_cb 的用户参数
+ *
+ * @return 成功: 定时器分组
+ * @return 失败: NULL
+ */
+hs_timer_group_t *hs_timer_group_create(hs_timer_engine_t *engine, const hs_timer_group_cb batch_cb, void *ctx);
+
+/**
+ * @brief 销毁定时器分组
+ *
+ * @note 1. 一次提交销毁分组中的全部定时器 (同 hs_timer_destroy())，之后不能再使用分组和其中的定时器
+ *       2. 分组的内存在最后一个成员被引擎回收后释放
+ *       3. 必须在销毁引擎前销毁分组
+ *
+ * @param[in,out] group: 定时器分组
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_group_destroy(hs_timer_group_t *group);
+
+/**
+ * @brief 暂停分组时钟
+ *
+ * @note 1. 分组时间停止前进，成员不再到期；成员各自的状态不变 (hs_timer_is_paused() 仍为 false)
+ *       2. 只修改分组时钟，不逐个处理成员；已到期、正在派发的成员照常执行
+ *       3. 已暂停时直接返回成功
+ *
+ * @param[in,out] group: 定时器分组
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_group_pause(hs_timer_group_t *group);
+
+/**
+ * @brief 恢复分组时钟
+ *
+ * @note 1. 分组时间从暂停时的值继续前进，成员保持暂停时的剩余时间 (与 hs_timer_resume() 重新计时不同)
+ *       2. 未暂停时直接返回成功
+ *
+ * @param[in,out] group: 定时器分组
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_group_resume(hs_timer_group_t *group);
+
+/**
+ * @brief 推迟分组中的全部定时器
+ *
+ * @note 1. 分组时间在之后的 delay_ns 内停止前进，所有成员的剩余时间整体增加 delay_ns
+ *       2. 分组已暂停时累计到恢复时生效
+ *
+ * @param[in,out] group   : 定时器分组
+ * @param[in]     delay_ns: 推迟的时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_group_postpone_ns(hs_timer_group_t *group, const uint64_t delay_ns);
+
+/**
+ * @brief 分组时钟是否已暂停
+ *
+ * @param[in] group: 定时器分组
+ *
+ * @return true : 已暂停
+ * @return false: 未暂停或参数错误
+ */
+bool hs_timer_group_is_paused(hs_timer_group_t *group);
+
+/**
+ * @brief 在分组中创建定时器对象
+ *
+ * @note 定时器创建在分组的引擎上，到销毁前一直属于该分组，用法与 hs_timer_create() 的返回值相同
+ *
+ * @param[in,out] group: 定时器分组
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL
+ */
+hs_timer_t *hs_timer_create_in_group(hs_timer_group_t *group);
+
+/**
+ * @brief 在用户提供的存储空间上创建定时器对象
+ *
+ * @note 1. 不进行堆内存分配，创建后用法与 hs_timer_create() 的返回值相同
+ *       2. 存储空间首次使用前必须清零 (如静态变量或 hs_timer_storage_t storage = {0})
+ *       3. 定时器销毁完成后存储空间会被标记为未使用，可以再次调用该函数复用
+ *       4. 存储空间仍被占用 (定时器尚未销毁完成) 时返回 NULL
+ *
+ * @param[in,out] storage: 存储空间，在定时器销毁完成前必须一直有效
+ * @param[in,out] engine : 定时器引擎 (NULL: 默认引擎)
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL
+ */
+hs_timer_t *hs_timer_init_static(hs_timer_storage_t *storage, hs_timer_engine_t *engine);
+
 /**
  * @brief 初始化定时器对象
  *
@@ -62,11 +647,31 @@ hs_timer_t *hs_timer_create(void);
 int hs_timer_init(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32_t repeat_count, const uint32_t timeout,
                   const void *user_data);
 
+/**
+ * @brief 初始化定时器对象 (纳秒精度)
+ *
+ * @note 1. 除超时时间单位外，与 hs_timer_init() 相同
+ *       2. 实际精度由所属引擎的节拍时长决定，到期时间向上对齐到节拍
+ *
+ * @param[in,out] hs_timer    : 定时器对象
+ * @param[in]     timer_cb    : 定时器回调函数
+ * @param[in]     repeat_count: 定时器重复次数
+ *                              HS_TIMER_REPEAT_ONCE: 执行一次
+ *                              HS_TIMER_REPEAT_FOREVER: 无限循环
+ * @param[in]     timeout_ns  : 定时器超时时间 (单位: ns)
+ * @param[in]     user_data   : 用户数据
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_init_ns(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32_t repeat_count,
+                     const uint64_t timeout_ns, const void *user_data);
+
 /**
  * @brief 销毁定时器对象
  *
- * @note 1. 未初始化的定时器会立即销毁
- *       2. 已初始化的定时器不会立即销毁，内部在合适的时机进行销毁
+ * @note 1. 不等待，引擎立即把定时器从时间轮中移除并回收，不会等到原来的到期时间
+ *       2. 回调函数正在执行时，回调结束后回收；本次回调结束后不会再执行回调
  *       3. 销毁后，定时器对象将不再可用
  *
  * @param[in,out] hs_timer: 定时器对象
@@ -76,6 +681,24 @@ int hs_timer_init(hs_timer_t *hs_timer, const hs_timer_cb timer_cb, const uint32
  */
 int hs_timer_destroy(hs_timer_t *hs_timer);
 
+/**
+ * @brief 销毁定时器对象，并等待正在执行的回调结束
+ *
+ * @note 1. 返回后回调函数不会再执行，定时器已被回收，可以安全释放回调中使用的资源
+ *       2. 不能在该定时器自己的回调函数中调用 (返回失败，不销毁)
+ *       3. 在回调直接在派发方执行的引擎 (worker_count 为 0 或外部驱动模式) 的回调函数中调用时，不需要等待，
+ *          与 hs_timer_destroy() 相同
+ *       4. 外部驱动模式下在其它线程调用时，等待事件循环下一次调用 hs_timer_engine_process_expired()
+ *       5. 重复次数用完后会自动销毁: 在最后一次回调执行期间或刚结束时调用，等待 (或确认) 回收完成后返回成功；
+ *          但定时器对象被回收后又被新创建的定时器复用时，不能再用原来的对象调用
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_destroy_sync(hs_timer_t *hs_timer);
+
 /**
  * @brief 设置定时器回调函数
  *
@@ -103,6 +726,8 @@ int hs_timer_set_repeat_count(hs_timer_t *hs_timer, const uint32_t repeat_count)
 /**
  * @brief 设置定时器超时时间
  *
+ * @note 运行中的定时器从当前时间重新计时；未启动或暂停中的定时器只更新超时时间，启动或恢复时生效
+ *
  * @param[in,out] hs_timer  : 定时器对象
  * @param[in]     timeout_ms: 定时器超时时间 (单位: ms)
  *
@@ -111,6 +736,106 @@ int hs_timer_set_repeat_count(hs_timer_t *hs_timer, const uint32_t repeat_count)
  */
 int hs_timer_set_timeout(hs_timer_t *hs_timer, const uint32_t timeout_ms);
 
+/**
+ * @brief 设置定时器超时时间 (纳秒精度)
+ *
+ * @note 与 hs_timer_set_timeout() 相同
+ *
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     timeout_ns: 定时器超时时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_set_timeout_ns(hs_timer_t *hs_timer, const uint64_t timeout_ns);
+
+/**
+ * @brief 从当前时间开始重新计时 (按定时器超时时间)
+ *
+ * @note 与 hs_timer_postpone_ns(hs_timer, 超时时间) 相同，适用于每次收到数据都要推迟的空闲超时
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_touch(hs_timer_t *hs_timer);
+
+/**
+ * @brief 推迟定时器到期时间
+ *
+ * @note 1. 新的到期时间为当前时间加 delay_ms，不改变定时器超时时间
+ *       2. 仅运行中的定时器可用
+ *       3. 新的到期时间不早于原到期时间时只记录到期时间，不提交给引擎，原到期时间到达时才重新加入时间轮
+ *       4. 新的到期时间早于原到期时间时，与重新启动相同
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     delay_ms: 从当前时间开始的延迟时间 (单位: ms)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_postpone(hs_timer_t *hs_timer, const uint32_t delay_ms);
+
+/**
+ * @brief 推迟定时器到期时间 (纳秒精度)
+ *
+ * @note 除延迟时间单位外，与 hs_timer_postpone() 相同
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     delay_ns: 从当前时间开始的延迟时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_postpone_ns(hs_timer_t *hs_timer, const uint64_t delay_ns);
+
+/**
+ * @brief 批量启动定时器
+ *
+ * @note 1. 对每个定时器相当于 hs_timer_set_timeout_ns() 加 hs_timer_resume()，仅运行中或暂停中的定时器可用
+ *       2. 同一引擎上连续的定时器只读取一次时钟、只加入一次命令队列、最多唤醒一次引擎
+ *       3. 为 NULL 或状态不允许的定时器直接跳过
+ *
+ * @param[in,out] hs_timers  : 定时器对象数组
+ * @param[in]     timeouts_ns: 各定时器的超时时间 (单位: ns; NULL: 使用各定时器原来的超时时间)
+ * @param[in]     count      : 定时器数量
+ *
+ * @return >=0: 启动的定时器数量
+ * @return <0 : 失败
+ */
+int hs_timer_arm_batch(hs_timer_t **hs_timers, const uint64_t *timeouts_ns, const size_t count);
+
+/**
+ * @brief 批量停止定时器
+ *
+ * @note 1. 对每个定时器相当于 hs_timer_pause()，之后可以用 hs_timer_resume() 或 hs_timer_arm_batch() 重新启动
+ *       2. 同一引擎上连续的定时器只加入一次命令队列、最多唤醒一次引擎
+ *       3. 为 NULL 或状态不允许的定时器直接跳过
+ *
+ * @param[in,out] hs_timers: 定时器对象数组
+ * @param[in]     count    : 定时器数量
+ *
+ * @return >=0: 停止的定时器数量
+ * @return <0 : 失败
+ */
+int hs_timer_cancel_batch(hs_timer_t **hs_timers, const size_t count);
+
+/**
+ * @brief 批量销毁定时器
+ *
+ * @note 1. 对每个定时器相当于 hs_timer_destroy()
+ *       2. 同一引擎上连续的定时器只加入一次命令队列、最多唤醒一次引擎
+ *       3. 为 NULL 或已销毁的定时器直接跳过，销毁后定时器对象将不再可用
+ *
+ * @param[in,out] hs_timers: 定时器对象数组
+ * @param[in]     count    : 定时器数量
+ *
+ * @return >=0: 销毁的定时器数量
+ * @return <0 : 失败
+ */
+int hs_timer_destroy_batch(hs_timer_t **hs_timers, const size_t count);
+
 /**
  * @brief 设置定时器用户数据
  *
@@ -122,6 +847,63 @@ int hs_timer_set_timeout(hs_timer_t *hs_timer, const uint32_t timeout_ms);
  */
 int hs_timer_set_user_data(hs_timer_t *hs_timer, const void *user_data);
 
+/**
+ * @brief 设置定时器释放回调函数
+ *
+ * @note 1. 在派发方回收定时器对象前调用，用于释放回调函数使用的资源 (如内嵌数据区中的对象)
+ *       2. 重复次数用完自动销毁、hs_timer_destroy() 和 hs_timer_destroy_sync() 都会调用
+ *
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     release_cb: 释放回调函数 (NULL: 不调用)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_set_release_cb(hs_timer_t *hs_timer, const hs_timer_release_cb release_cb);
+
+/**
+ * @brief 设置周期定时器调度策略
+ *
+ * @note 1. 默认为 E_HS_TIMER_PERIODIC_RELATIVE
+ *       2. 绝对到期时间从最近一次启动 (初始化、设置超时时间、就绪、恢复) 的时间开始计算
+ *
+ * @param[in,out] hs_timer     : 定时器对象
+ * @param[in]     periodic_mode: 周期定时器调度策略
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_set_periodic_mode(hs_timer_t *hs_timer, const hs_timer_periodic_mode_e periodic_mode);
+
+/**
+ * @brief 设置定时器优先级
+ *
+ * @note 1. 默认为 E_HS_TIMER_PRIORITY_NORMAL
+ *       2. 下一次到期时生效
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     priority: 优先级
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_set_priority(hs_timer_t *hs_timer, const hs_timer_priority_e priority);
+
+/**
+ * @brief 设置定时器允许延后到期的时间
+ *
+ * @note 1. 引擎可以把到期时间最多延后 slack_ns，使到期窗口重叠的定时器在同一次唤醒中执行，减少唤醒次数
+ *       2. 默认值为所属引擎配置的 slack_ns
+ *       3. 下一次启动时生效
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     slack_ns: 允许延后到期的时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_set_slack_ns(hs_timer_t *hs_timer, const uint64_t slack_ns);
+
 /**
  * @brief 获取定时器重复次数
  *
@@ -146,6 +928,87 @@ int hs_timer_get_repeat_count(hs_timer_t *hs_timer, uint32_t *repeat_count);
  */
 int hs_timer_get_timeout(hs_timer_t *hs_timer, uint32_t *timeout_ms);
 
+/**
+ * @brief 获取定时器超时时间 (纳秒精度)
+ *
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[out]    timeout_ns: 定时器超时时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_get_timeout_ns(hs_timer_t *hs_timer, uint64_t *timeout_ns);
+
+/**
+ * @brief 获取本次回调错过的周期数
+ *
+ * @note 1. 在回调函数中调用
+ *       2. E_HS_TIMER_PERIODIC_SKIP: 本次回调之前跳过的周期数
+ *       3. E_HS_TIMER_PERIODIC_COALESCE: 本次回调额外合并的周期数
+ *       4. 其它策略下始终为 0
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[out]    overrun : 错过的周期数
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_get_overrun(hs_timer_t *hs_timer, uint32_t *overrun);
+
+/**
+ * @brief 获取定时器允许延后到期的时间
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[out]    slack_ns: 允许延后到期的时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_get_slack_ns(hs_timer_t *hs_timer, uint64_t *slack_ns);
+
+/**
+ * @brief 获取定时器距离到期的时间
+ *
+ * @note 1. 读取定时器缓存的到期时间和引擎时钟 (vDSO 或 TSC)，不进入内核，不等待派发方
+ *       2. 分组成员按分组时钟计算，分组暂停期间剩余时间不变
+ *       3. 已到期但回调尚未开始时为 0；实际到期可能因延后容忍度 (slack) 略晚
+ *
+ * @param[in,out] hs_timer    : 定时器对象
+ * @param[out]    remaining_ns: 距离到期的时间 (单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (-2: 定时器未在运行)
+ */
+int hs_timer_get_remaining_ns(hs_timer_t *hs_timer, uint64_t *remaining_ns);
+
+/**
+ * @brief 获取定时器下一次到期的时间
+ *
+ * @note 1. 与 hs_timer_get_remaining_ns() 相同，只读取缓存的到期时间，不进入内核
+ *       2. 返回引擎时钟的绝对时间，可以与 hs_timer_engine_now_ns() 比较
+ *       3. 分组成员按当前分组时钟换算为引擎时间，分组已暂停时为 UINT64_MAX
+ *
+ * @param[in,out] hs_timer   : 定时器对象
+ * @param[out]    deadline_ns: 下一次到期的时间 (引擎时钟, 单位: ns)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (-2: 定时器未在运行)
+ */
+int hs_timer_get_next_deadline(hs_timer_t *hs_timer, uint64_t *deadline_ns);
+
+/**
+ * @brief 获取定时器统计
+ *
+ * @note 定时器重新初始化不会清除统计
+ *
+ * @param[in]  hs_timer: 定时器对象
+ * @param[out] stats   : 定时器统计
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_get_stats(hs_timer_t *hs_timer, hs_timer_stats_t *stats);
+
 /**
  * @brief 获取定时器用户数据
  *
@@ -155,6 +1018,19 @@ int hs_timer_get_timeout(hs_timer_t *hs_timer, uint32_t *timeout_ms);
  */
 const void *hs_timer_get_user_data(hs_timer_t *hs_timer);
 
+/**
+ * @brief 获取定时器对象内嵌的用户数据区
+ *
+ * @note 1. 大小为 HS_TIMER_INLINE_DATA_SIZE，按 8 字节对齐，创建时内容未定义
+ *       2. 随定时器对象分配和回收，不需要额外的堆内存；定时器回收后不能再访问
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return 成功: 内嵌数据区
+ * @return 失败: NULL
+ */
+void *hs_timer_get_inline_data(hs_timer_t *hs_timer);
+
 /**
  * @brief 设置定时器就绪
  *
@@ -177,6 +1053,20 @@ int hs_timer_ready(hs_timer_t *hs_timer);
  */
 int hs_timer_pause(hs_timer_t *hs_timer);
 
+/**
+ * @brief 延迟取消定时器
+ *
+ * @note 1. 只把定时器标记为已暂停，不加锁、不通知引擎，适合大多数在到期前就取消的超时
+ *       2. 定时器作为墓碑留在时间轮或堆中，派发方到达时直接丢弃，或在墓碑较多时统一压缩移除
+ *       3. 之后与 hs_timer_pause() 后相同，可以用 hs_timer_resume() 重新启动或直接销毁
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_cancel_lazy(hs_timer_t *hs_timer);
+
 /**
  * @brief 恢复定时器
  *
@@ -197,6 +1087,23 @@ int hs_timer_resume(hs_timer_t *hs_timer);
  */
 bool hs_timer_is_paused(hs_timer_t *hs_timer);
 
+/**
+ * @brief 设置跟踪回调函数
+ *
+ * @note 1. 跟踪点只在编译时定义了 HS_TIMER_ENABLE_TRACE (CMake 选项 HS_TIMER_TRACE) 时存在；
+ *          未启用时跟踪点不产生任何代码，该函数返回 -2
+ *       2. 启用后每个跟踪点是一次原子读取和一次预测为不成立的分支；系统提供 <sys/sdt.h> 时
+ *          同时生成 USDT 探针 (provider 为 hs_timer，探针名为事件名，如 CALLBACK_BEGIN)，
+ *          未挂载时探针只是一条 nop
+ *       3. 对所有引擎生效，可以随时设置或清除；清除后正在执行的跟踪回调可能仍未返回
+ *
+ * @param[in] trace_cb: 跟踪回调函数 (NULL: 关闭跟踪回调)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_timer_trace_set_cb(const hs_timer_trace_cb trace_cb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,437 @@
+/**
+ * @file      hs_timer.hpp
+ * @brief     定时器模块 C++ 头文件 (仅头文件)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 19:02:47
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_TIMER_HPP
+#define __HS_TIMER_HPP
+
+#include <new>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "hs_timer.h"
+
+namespace hs
+{
+
+namespace detail
+{
+
+// 回调对象的操作函数 (每种回调类型一份，放在内嵌数据区开头)
+struct timer_ops
+{
+    void (*invoke)(void *callable, hs_timer_t *hs_timer); // 调用回调对象
+    void (*destroy)(void *callable);                      // 析构回调对象
+};
+
+// 内嵌数据区的开头 (之后存放回调对象)
+struct timer_slot
+{
+    const timer_ops *ops;  // 回调对象的操作函数
+    uint32_t repeat_count; // 每轮的重复次数 (HS_TIMER_REPEAT_FOREVER: 无限循环)
+    uint32_t remaining;    // 本轮剩余的重复次数 (只在回调中访问)
+};
+
+// 内嵌数据区中存放回调对象的空间
+constexpr std::size_t timer_inline_offset = sizeof(timer_slot);
+constexpr std::size_t timer_inline_size = HS_TIMER_INLINE_DATA_SIZE - timer_inline_offset;
+constexpr std::size_t timer_inline_align = 8;
+
+/**
+ * @brief 调用回调对象 (回调对象接受定时器对象参数)
+ */
+template <typename F>
+inline auto timer_call(F &callable, hs_timer_t *hs_timer, int) -> decltype(callable(hs_timer), void())
+{
+    callable(hs_timer);
+}
+
+/**
+ * @brief 调用回调对象 (回调对象不接受参数)
+ */
+template <typename F>
+inline auto timer_call(F &callable, hs_timer_t *, long) -> decltype(callable(), void())
+{
+    callable();
+}
+
+// 回调对象直接存放在内嵌数据区中
+template <typename F>
+struct timer_inline_ops
+{
+    static void invoke(void *callable, hs_timer_t *hs_timer)
+    {
+        timer_call(*static_cast<F *>(callable), hs_timer, 0);
+    }
+
+    static void destroy(void *callable)
+    {
+        static_cast<F *>(callable)->~F();
+    }
+
+    static constexpr timer_ops ops = {invoke, destroy};
+};
+
+template <typename F>
+constexpr timer_ops timer_inline_ops<F>::ops;
+
+// 回调对象放不下时分配在堆上，内嵌数据区中只存放指针
+template <typename F>
+struct timer_heap_ops
+{
+    static void invoke(void *callable, hs_timer_t *hs_timer)
+    {
+        timer_call(**static_cast<F **>(callable), hs_timer, 0);
+    }
+
+    static void destroy(void *callable)
+    {
+        delete *static_cast<F **>(callable);
+    }
+
+    static constexpr timer_ops ops = {invoke, destroy};
+};
+
+template <typename F>
+constexpr timer_ops timer_heap_ops<F>::ops;
+
+// 回调对象是否可以直接存放在内嵌数据区中
+template <typename F>
+struct timer_fits_inline
+    : std::integral_constant<bool, (sizeof(F) <= timer_inline_size) && (alignof(F) <= timer_inline_align)>
+{
+};
+
+/**
+ * @brief 定时器回调函数 (转发给内嵌数据区中的回调对象)
+ *
+ * @note 定时器按无限循环启动，重复次数在这里计数，用完后暂停而不是自动销毁，保证句柄一直持有有效的定时器
+ */
+inline void timer_trampoline(hs_timer_t *hs_timer)
+{
+    char *data = static_cast<char *>(hs_timer_get_inline_data(hs_timer));
+    timer_slot *slot = reinterpret_cast<timer_slot *>(data);
+    bool last = ((slot->repeat_count != HS_TIMER_REPEAT_FOREVER) && (--slot->remaining == 0));
+    if (last)
+    {
+        slot->remaining = slot->repeat_count;
+        hs_timer_pause(hs_timer);
+    }
+
+    slot->ops->invoke(data + timer_inline_offset, hs_timer);
+}
+
+/**
+ * @brief 定时器释放回调函数 (析构内嵌数据区中的回调对象)
+ */
+inline void timer_release(hs_timer_t *hs_timer)
+{
+    char *data = static_cast<char *>(hs_timer_get_inline_data(hs_timer));
+    reinterpret_cast<timer_slot *>(data)->ops->destroy(data + timer_inline_offset);
+}
+
+/**
+ * @brief 构造回调对象 (直接存放在内嵌数据区中)
+ */
+template <typename F>
+inline bool timer_emplace(void *data, F &&callable, std::true_type)
+{
+    using callable_t = typename std::decay<F>::type;
+    ::new (static_cast<char *>(data) + timer_inline_offset) callable_t(std::forward<F>(callable));
+    static_cast<timer_slot *>(data)->ops = &timer_inline_ops<callable_t>::ops;
+
+    return true;
+}
+
+/**
+ * @brief 构造回调对象 (分配在堆上)
+ */
+template <typename F>
+inline bool timer_emplace(void *data, F &&callable, std::false_type)
+{
+    using callable_t = typename std::decay<F>::type;
+    callable_t *heap = new (std::nothrow) callable_t(std::forward<F>(callable));
+    if (heap == nullptr)
+    {
+        return false;
+    }
+    *reinterpret_cast<callable_t **>(static_cast<char *>(data) + timer_inline_offset) = heap;
+    static_cast<timer_slot *>(data)->ops = &timer_heap_ops<callable_t>::ops;
+
+    return true;
+}
+
+// 构造过程中的定时器 (未完成时析构会销毁定时器)
+struct timer_guard
+{
+    hs_timer_t *hs_timer;
+
+    ~timer_guard()
+    {
+        if (hs_timer != nullptr)
+        {
+            hs_timer_destroy(hs_timer);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 定时器句柄
+ *
+ * @note 1. 只能移动，不能复制；析构时销毁定时器 (不等待正在执行的回调，回调对象在回调结束后析构)
+ *       2. 回调对象 (lambda 等) 不超过 HS_TIMER_INLINE_DATA_SIZE - 16 字节且按不超过 8 字节对齐时，直接存放在
+ *          定时器对象内，不分配堆内存；否则分配在堆上
+ *       3. 回调对象可以不接受参数，也可以接受 hs_timer_t * 参数 (用于调用 hs_timer_get_overrun() 等)，
+ *          回调需要的上下文直接通过捕获传入，不需要 hs_timer_get_user_data()
+ *       4. 重复次数用完后定时器暂停而不是自动销毁，resume() 后重新执行一轮；句柄析构前定时器一直有效
+ *       5. 不要对 get() 返回的定时器调用 hs_timer_set_cb()、hs_timer_set_user_data() 等会替换回调的 C 接口
+ */
+class timer
+{
+public:
+    timer() noexcept = default;
+
+    /**
+     * @brief 创建并启动定时器
+     *
+     * @note 创建失败时句柄为空 (valid() 返回 false)；复制回调对象时抛出的异常会继续抛出，定时器已销毁
+     *
+     * @param[in] callable    : 回调对象
+     * @param[in] repeat_count: 重复次数 (HS_TIMER_REPEAT_ONCE: 执行一次; HS_TIMER_REPEAT_FOREVER: 无限循环)
+     * @param[in] timeout     : 超时时间
+     * @param[in] engine      : 所属引擎 (nullptr: 默认引擎)
+     */
+    template <typename F, typename Rep, typename Period,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, timer>::value>::type>
+    timer(F &&callable, const uint32_t repeat_count, const std::chrono::duration<Rep, Period> timeout,
+          hs_timer_engine_t *engine = nullptr)
+    {
+        using callable_t = typename std::decay<F>::type;
+
+        detail::timer_guard guard = {(engine != nullptr) ? hs_timer_create_on(engine) : hs_timer_create()};
+        if (guard.hs_timer == nullptr)
+        {
+            return;
+        }
+
+        void *data = hs_timer_get_inline_data(guard.hs_timer);
+        detail::timer_slot *slot = static_cast<detail::timer_slot *>(data);
+        slot->repeat_count = repeat_count;
+        slot->remaining = repeat_count;
+        if ((repeat_count == 0) ||
+            !detail::timer_emplace(data, std::forward<F>(callable), detail::timer_fits_inline<callable_t>()))
+        {
+            return;
+        }
+
+        // 设置释放回调后，回调对象由释放回调析构
+        if (hs_timer_set_release_cb(guard.hs_timer, detail::timer_release) != 0)
+        {
+            detail::timer_release(guard.hs_timer);
+
+            return;
+        }
+
+        uint64_t timeout_ns = to_ns(timeout);
+        if (hs_timer_init_ns(guard.hs_timer, detail::timer_trampoline, HS_TIMER_REPEAT_FOREVER, timeout_ns, nullptr) != 0)
+        {
+            return;
+        }
+
+        hs_timer_ = guard.hs_timer;
+        guard.hs_timer = nullptr;
+    }
+
+    timer(const timer &) = delete;
+    timer &operator=(const timer &) = delete;
+
+    timer(timer &&other) noexcept : hs_timer_(other.hs_timer_)
+    {
+        other.hs_timer_ = nullptr;
+    }
+
+    timer &operator=(timer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            hs_timer_ = other.hs_timer_;
+            other.hs_timer_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    ~timer()
+    {
+        reset();
+    }
+
+    /**
+     * @brief 句柄是否持有定时器
+     */
+    bool valid() const noexcept
+    {
+        return (hs_timer_ != nullptr);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return valid();
+    }
+
+    /**
+     * @brief 获取定时器对象 (用于调用 C 接口)
+     */
+    hs_timer_t *get() const noexcept
+    {
+        return hs_timer_;
+    }
+
+    /**
+     * @brief 放弃对定时器的所有权
+     *
+     * @note 之后由调用者负责销毁，回调对象仍在定时器回收时析构
+     *
+     * @return 定时器对象
+     */
+    hs_timer_t *release() noexcept
+    {
+        hs_timer_t *hs_timer = hs_timer_;
+        hs_timer_ = nullptr;
+
+        return hs_timer;
+    }
+
+    /**
+     * @brief 销毁定时器 (不等待)
+     *
+     * @note 与 hs_timer_destroy() 相同，可以在该定时器自己的回调中调用
+     */
+    void reset() noexcept
+    {
+        if (hs_timer_ != nullptr)
+        {
+            hs_timer_destroy(hs_timer_);
+            hs_timer_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief 销毁定时器，并等待正在执行的回调结束
+     *
+     * @note 与 hs_timer_destroy_sync() 相同，返回 0 后回调对象已析构
+     *
+     * @return 0 : 成功
+     * @return <0: 失败 (句柄不变)
+     */
+    int reset_sync() noexcept
+    {
+        int ret = hs_timer_destroy_sync(hs_timer_);
+        if (ret == 0)
+        {
+            hs_timer_ = nullptr;
+        }
+
+        return ret;
+    }
+
+    /**
+     * @brief 暂停定时器
+     */
+    int pause() noexcept
+    {
+        return hs_timer_pause(hs_timer_);
+    }
+
+    /**
+     * @brief 延迟取消定时器 (只标记为已暂停，由引擎之后统一清理)
+     */
+    int cancel_lazy() noexcept
+    {
+        return hs_timer_cancel_lazy(hs_timer_);
+    }
+
+    /**
+     * @brief 恢复定时器
+     */
+    int resume() noexcept
+    {
+        return hs_timer_resume(hs_timer_);
+    }
+
+    /**
+     * @brief 立即触发定时器
+     */
+    int ready() noexcept
+    {
+        return hs_timer_ready(hs_timer_);
+    }
+
+    /**
+     * @brief 从现在起重新计时 (与 hs_timer_touch() 相同)
+     */
+    int touch() noexcept
+    {
+        return hs_timer_touch(hs_timer_);
+    }
+
+    /**
+     * @brief 设置超时时间 (与 hs_timer_set_timeout_ns() 相同)
+     */
+    template <typename Rep, typename Period>
+    int set_timeout(const std::chrono::duration<Rep, Period> timeout) noexcept
+    {
+        return hs_timer_set_timeout_ns(hs_timer_, to_ns(timeout));
+    }
+
+    /**
+     * @brief 推迟到期时间 (与 hs_timer_postpone_ns() 相同)
+     */
+    template <typename Rep, typename Period>
+    int postpone(const std::chrono::duration<Rep, Period> delay) noexcept
+    {
+        return hs_timer_postpone_ns(hs_timer_, to_ns(delay));
+    }
+
+    /**
+     * @brief 获取距离到期的时间 (与 hs_timer_get_remaining_ns() 相同)
+     */
+    int remaining(std::chrono::nanoseconds &remaining) const noexcept
+    {
+        uint64_t remaining_ns = 0;
+        int ret = hs_timer_get_remaining_ns(hs_timer_, &remaining_ns);
+        if (ret == 0)
+        {
+            remaining = std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(remaining_ns));
+        }
+
+        return ret;
+    }
+
+private:
+    /**
+     * @brief 转换为纳秒数
+     */
+    template <typename Rep, typename Period>
+    static uint64_t to_ns(const std::chrono::duration<Rep, Period> duration) noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    hs_timer_t *hs_timer_ = nullptr; // 定时器对象
+};
+
+} // namespace hs
+
+#endif // __HS_TIMER_HPP
@@ -0,0 +1,3363 @@
+/**
+ * @file      hs_timer_engine.c
+ * @brief     定时器引擎源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 09:26:37
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include "hs_timer_internal.h"
+
+// 到期链表
+typedef struct hs_timer_expire_list
+{
+    hs_timer_t *head; // 链表头
+    hs_timer_t *tail; // 链表尾
+} hs_timer_expire_list_t;
+
+#define HS_TIMER_ENGINE_SLAB_TIMERS (64U) // 对象池每次分配的定时器数量
+
+// 对象池内存块
+typedef struct hs_timer_slab
+{
+    struct hs_timer_slab *next;                   // 下一个内存块
+    hs_timer_t timers[HS_TIMER_ENGINE_SLAB_TIMERS]; // 定时器对象
+} hs_timer_slab_t;
+
+#define HS_TIMER_ENGINE_CACHE_LINE (64U) // 缓存行大小
+
+#define HS_TIMER_ENGINE_TSC_CALIBRATE_NS (10000000ULL) // TSC 校准时长 (单位: ns)
+
+// 换算需要 128 位乘除法，没有 128 位整数的平台 (32 位目标) 不支持 TSC 时钟
+#if defined(__SIZEOF_INT128__) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#define HS_TIMER_ENGINE_HAS_TSC
+__extension__ typedef unsigned __int128 hs_timer_engine_u128_t;
+#endif
+
+// TSC 与 CLOCK_MONOTONIC 的换算 (时间 = base_ns + ((计数 - base) * mult) >> 32)
+typedef struct hs_timer_engine_tsc
+{
+    bool usable;      // 是否可用 (处理器支持恒定频率的 TSC 且校准成功)
+    uint64_t base;    // 校准结束时的计数
+    uint64_t base_ns; // 校准结束时的 CLOCK_MONOTONIC 时间 (单位: ns)
+    uint64_t mult;    // 每个计数的纳秒数 (定点数, 32 位小数)
+} hs_timer_engine_tsc_t;
+
+// 统计块 (每个回调执行线程一个，独占缓存行，只由该线程写入)
+typedef struct hs_timer_engine_stats_block
+{
+    hs_timer_engine_t *engine;     // 所属引擎
+    uint64_t expired_count;        // 回调执行次数
+    uint64_t overrun_count;        // 合并或跳过的周期总数
+    hs_timer_histogram_t lateness; // 回调开始时间相对到期时间的延迟
+    hs_timer_histogram_t callback; // 回调耗时
+    hs_timer_t *running;           // 正在执行到期处理的定时器 (仅回调工作线程; fork() 后用于结束被中断的到期处理)
+    uint32_t running_generation;   // running 的分配序号
+} __attribute__((aligned(HS_TIMER_ENGINE_CACHE_LINE))) hs_timer_engine_stats_block_t;
+
+// 定时器引擎
+struct _hs_timer_engine
+{
+    // 以下成员只由派发方 (派发线程或调用 hs_timer_engine_process_expired() 的线程) 访问
+    hs_timer_wheel_t wheel;         // 时间轮 (wheel.tick 同时作为堆的当前节拍)
+    hs_timer_heap_t heap;           // 堆 (仅堆和混合模式使用)
+    hs_timer_expire_list_t expired; // 本轮到期的定时器
+    hs_timer_expire_list_t ready;   // 超出派发预算、等待之后派发的定时器 (按到期时间排序)
+    hs_timer_group_t *groups;       // 分组时间轮中有定时器的分组链表 (每个分组持有一个引用)
+    hs_timer_t *cmd_retry_head;     // 已取出但提交方还没置位 HS_TIMER_CMD_LINKED、留到下一次处理的定时器 (通过 cmd_next 连接)
+    hs_timer_t *cmd_retry_tail;     // cmd_retry_head 链表尾
+    uint32_t round_count;           // 本次唤醒已派发的定时器数量
+    uint64_t round_start_ns;        // 本次唤醒开始派发的时间 (引擎时钟, 单位: ns)
+    uint64_t armed_tick;            // timerfd 当前设定的节拍 (HS_TIMER_WHEEL_NEVER: 未设定)
+    uint64_t wakeup_count;          // 派发方处理次数 (其它线程原子读取)
+    uint64_t active_count;          // 时间轮和堆中的定时器数量 (每轮处理结束时写入，其它线程原子读取)
+    uint64_t ready_count;           // ready 中的定时器数量 (其它线程原子读取)
+    uint64_t tombstone_dropped;     // 派发方到达时直接丢弃的墓碑数量 (其它线程原子读取)
+    uint64_t compact_count;         // 压缩次数 (其它线程原子读取)
+    uint64_t compacted_count;       // 压缩时移除的墓碑数量 (其它线程原子读取)
+    uint64_t spin_count;            // 派发线程自旋等待的次数 (其它线程原子读取)
+    uint64_t spin_total_ns;         // 派发线程自旋的总时长 (其它线程原子读取)
+
+    // 以下成员创建后不变
+    uint64_t tick_ns;                            // 节拍时长 (单位: ns)
+    uint64_t slack_ns;                           // 新建定时器默认允许延后到期的时间 (单位: ns)
+    int timer_fd;                                // 驱动所有定时器的 timerfd
+    int event_fd;                                // 唤醒派发方的 eventfd
+    int poll_fd;                                 // 同时监听 timer_fd 和 event_fd 的 epoll 描述符
+    bool is_builtin;                             // 是否为默认引擎或分片引擎 (不能销毁)
+    hs_timer_engine_clock_e clock;               // 引擎时钟
+    clockid_t clock_id;                          // 读取引擎时钟使用的时钟 (仅 clock_gettime() 读取的时钟)
+    clockid_t timer_clock_id;                    // timerfd 使用的时钟
+    uint64_t clock_lag_ns;                       // 引擎时钟最多落后 timerfd 时钟的时间 (设置 timerfd 时推后, 单位: ns)
+    uint64_t spin_ns;                            // 派发线程到期前自旋等待的时间 (单位: ns; 0: 不自旋)
+    int32_t cpu;                                 // 引擎线程绑定的 CPU (HS_TIMER_ENGINE_CPU_ANY: 不绑定)
+    hs_timer_engine_mode_e mode;                 // 运行模式
+    hs_timer_engine_backend_e backend;           // 到期时间管理方式
+    pthread_t thread;                            // 派发线程 (仅自带线程模式)
+    hs_timer_engine_stats_block_t *stats_blocks; // 统计块 (0: 派发方; 之后每个回调工作线程一个; 最后一个: 执行器线程共用)
+    hs_timer_executor_submit_cb executor_submit; // 回调执行器 (NULL: 使用引擎自己的线程)
+    void *executor_ctx;                          // 传给 executor_submit 的用户参数
+    uint32_t dispatch_budget;                    // 每次唤醒最多派发的回调数 (0: 不限制)
+    uint64_t dispatch_budget_ns;                 // 每次唤醒派发回调的时间预算 (单位: ns; 0: 不限制)
+    int32_t high_worker_policy;                  // 高优先级回调工作线程的调度策略 (0: 不修改)
+    int32_t high_worker_sched_priority;          // 高优先级回调工作线程的调度优先级
+    uint32_t compact_percent;                    // 触发压缩的墓碑占比 (百分比; 0: 不压缩)
+
+    // 以下成员无锁访问，统一使用 __atomic 内建函数读写
+    hs_timer_t *cmd_head;     // 命令队列 (多生产者单消费者栈，派发方一次取出全部)
+    uint64_t wake_ns;         // 派发方下一次唤醒的时间 (引擎时钟, 单位: ns; UINT64_MAX: 不会唤醒)
+    uint64_t task_count;      // 已提交给执行器、尚未结束的任务数
+    uint64_t tombstone_count; // 已标记为墓碑的定时器数量
+    bool wake_pending;        // 是否已写入 eventfd 且派发方尚未开始处理
+    bool stopping;            // 是否正在停止 (在互斥锁内写入，回调工作线程等待工作时配合条件变量读取)
+
+    pthread_mutex_t mutex;                 // 互斥锁 (保护以下成员)
+    pthread_cond_t work_cond;              // 工作队列条件变量
+    hs_timer_expire_list_t work_list;      // 工作队列 (等待回调工作线程执行的到期定时器)
+    uint32_t worker_count;                 // 回调工作线程数
+    pthread_cond_t high_work_cond;         // 高优先级工作队列条件变量
+    hs_timer_expire_list_t high_work_list; // 高优先级工作队列 (等待高优先级回调工作线程执行的到期定时器)
+    uint32_t high_worker_count;            // 高优先级回调工作线程数
+    pthread_t *workers;                    // 回调工作线程 (先普通，后高优先级)
+    pthread_cond_t sync_cond;              // 同步请求完成条件变量
+    uint64_t sync_request;                 // 同步请求序号
+    uint64_t sync_done;                    // 已完成的同步请求序号
+    uint32_t worker_started;               // 已启动的回调工作线程数 (用于分配统计块)
+
+    pthread_mutex_t stats_mutex; // 执行器线程共用统计块的互斥锁
+    pthread_mutex_t run_mutex;   // 派发互斥锁 (派发方每轮处理期间持有，fork() 前等待本轮处理结束)
+
+    pthread_mutex_t pool_mutex;   // 对象池互斥锁
+    hs_timer_slab_t *slabs;       // 对象池内存块链表 (只在头部添加，引擎销毁前不释放，遍历时无锁读取)
+    hs_timer_t *free_list;        // 空闲定时器链表 (通过 expire_next 连接)
+    uint64_t timer_count;         // 引擎上的定时器数量 (由对象池互斥锁保护)
+    hs_timer_t *static_timers;    // 用户存储空间上的定时器链表 (由对象池互斥锁保护)
+    uint64_t static_count;        // 用户存储空间上的定时器数量 (由对象池互斥锁保护)
+    hs_timer_group_t *all_groups; // 引擎上的全部分组 (由对象池互斥锁保护)
+
+    struct _hs_timer_engine *engine_prev; // 引擎链表的上一个 (由 s_engine_mutex 保护)
+    struct _hs_timer_engine *engine_next; // 引擎链表的下一个 (由 s_engine_mutex 保护)
+};
+
+static pthread_once_t s_default_engine_once = PTHREAD_ONCE_INIT;
+static hs_timer_engine_t *s_default_engine = NULL;
+
+static pthread_once_t s_shard_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t s_shard_mutex = PTHREAD_MUTEX_INITIALIZER;
+static hs_timer_engine_t **s_shards = NULL; // 分片引擎 (按 CPU 编号索引，首次使用时创建)
+static uint32_t s_shard_count = 0;          // 分片数量
+
+static pthread_once_t s_atfork_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t s_engine_mutex = PTHREAD_MUTEX_INITIALIZER;
+static hs_timer_engine_t *s_engines = NULL; // 已创建的引擎链表 (fork() 时逐个处理)
+static bool s_fork_skip = false;            // 本次 fork() 由引擎的派发方或回调工作线程发起，不处理引擎
+
+static pthread_once_t s_tsc_once = PTHREAD_ONCE_INIT;
+static hs_timer_engine_tsc_t s_tsc = {0}; // TSC 换算参数 (校准后不变)
+
+// 当前线程正在作为派发方处理的引擎 (在派发方提交的命令本轮就会处理，不需要唤醒)
+static __thread hs_timer_engine_t *s_current_engine = NULL;
+
+// 当前线程执行回调时使用的统计块
+static __thread hs_timer_engine_stats_block_t *s_stats_block = NULL;
+
+/**
+ * @brief 读取处理器计数器
+ *
+ * @return 计数 (不支持的平台为 0)
+ */
+static inline uint64_t hs_timer_engine_read_tsc(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value = 0;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(value));
+
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 处理器计数器是否以恒定频率运行
+ *
+ * @note x86 需要 invariant TSC (CPUID 0x80000007 EDX[8])，AArch64 的通用定时器始终为恒定频率
+ *
+ * @return true : 是
+ * @return false: 否
+ */
+static bool hs_timer_engine_tsc_invariant(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+
+    return ((edx & (1U << 8)) != 0);
+#elif defined(__aarch64__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 同时读取处理器计数器和 CLOCK_MONOTONIC
+ *
+ * @param[out] tsc: 计数 (取 clock_gettime() 前后两次读取的中点)
+ *
+ * @return CLOCK_MONOTONIC 时间 (单位: ns)
+ */
+static uint64_t hs_timer_engine_sample_tsc(uint64_t *tsc)
+{
+    struct timespec now = {0};
+    uint64_t before = hs_timer_engine_read_tsc();
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t after = hs_timer_engine_read_tsc();
+    *tsc = before + ((after - before) / 2);
+
+    return ((uint64_t)now.tv_sec * HS_TIMER_NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief 校准处理器计数器
+ *
+ * @note 进程内只校准一次，所有使用 TSC 的引擎共用换算参数
+ */
+static void hs_timer_engine_tsc_init(void)
+{
+#ifdef HS_TIMER_ENGINE_HAS_TSC
+    if (!hs_timer_engine_tsc_invariant())
+    {
+        return;
+    }
+
+    uint64_t start = 0;
+    uint64_t start_ns = hs_timer_engine_sample_tsc(&start);
+    struct timespec interval = {0, (long)HS_TIMER_ENGINE_TSC_CALIBRATE_NS};
+    while ((nanosleep(&interval, &interval) != 0) && (errno == EINTR))
+    {
+    }
+    uint64_t end = 0;
+    uint64_t end_ns = hs_timer_engine_sample_tsc(&end);
+    if ((end <= start) || (end_ns <= start_ns))
+    {
+        return;
+    }
+
+    s_tsc.base = end;
+    s_tsc.base_ns = end_ns;
+    s_tsc.mult = (uint64_t)(((hs_timer_engine_u128_t)(end_ns - start_ns) << 32) / (end - start));
+    s_tsc.usable = (s_tsc.mult != 0);
+#endif
+}
+
+/**
+ * @brief 将时间转换为节拍
+ *
+ * @note 向上取整，保证定时器不会提前到期
+ *
+ * @param[in] engine: 引擎
+ * @param[in] ns    : 时间 (单位: ns)
+ *
+ * @return 节拍
+ */
+static uint64_t hs_timer_engine_ns_to_tick(const hs_timer_engine_t *engine, const uint64_t ns)
+{
+    return (ns / engine->tick_ns) + (((ns % engine->tick_ns) != 0) ? 1 : 0);
+}
+
+/**
+ * @brief 计算考虑延后容忍度后的到期节拍
+ *
+ * @note 在 [最早节拍, 最晚节拍] 中选择低位 0 最多的节拍，窗口重叠的定时器会落到同一节拍上
+ *
+ * @param[in] engine     : 引擎
+ * @param[in] deadline_ns: 到期时间 (单位: ns)
+ * @param[in] slack_ns   : 允许延后到期的时间 (单位: ns)
+ *
+ * @return 到期节拍
+ */
+static uint64_t hs_timer_engine_apply_slack(const hs_timer_engine_t *engine, const uint64_t deadline_ns,
+                                            const uint64_t slack_ns)
+{
+    uint64_t expires = hs_timer_engine_ns_to_tick(engine, deadline_ns);
+    if (slack_ns == 0)
+    {
+        return expires;
+    }
+
+    uint64_t limit_ns = (slack_ns > (UINT64_MAX - deadline_ns)) ? UINT64_MAX : (deadline_ns + slack_ns);
+    uint64_t limit = limit_ns / engine->tick_ns;
+    if (limit <= expires)
+    {
+        return expires;
+    }
+
+    // 保留两者相同的高位，清除最高不同位以下的所有位，结果仍在窗口内
+    uint32_t bit = (uint32_t)(63 - __builtin_clzll(expires ^ limit));
+
+    return limit & ~((1ULL << bit) - 1);
+}
+
+/**
+ * @brief 将定时器追加到链表尾部
+ *
+ * @param[in,out] list    : 链表
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_expire_list_push(hs_timer_expire_list_t *list, hs_timer_t *hs_timer)
+{
+    hs_timer->expire_next = NULL;
+    if (list->tail == NULL)
+    {
+        list->head = hs_timer;
+    }
+    else
+    {
+        list->tail->expire_next = hs_timer;
+    }
+    list->tail = hs_timer;
+}
+
+/**
+ * @brief 将链表追加到另一个链表尾部
+ *
+ * @param[in,out] list : 目标链表
+ * @param[in,out] other: 被追加的链表 (追加后清空)
+ */
+static void hs_timer_expire_list_splice(hs_timer_expire_list_t *list, hs_timer_expire_list_t *other)
+{
+    if (other->head == NULL)
+    {
+        return;
+    }
+
+    if (list->tail == NULL)
+    {
+        list->head = other->head;
+    }
+    else
+    {
+        list->tail->expire_next = other->head;
+    }
+    list->tail = other->tail;
+
+    other->head = NULL;
+    other->tail = NULL;
+}
+
+/**
+ * @brief 从链表头部取出定时器
+ *
+ * @param[in,out] list: 链表
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL (链表为空)
+ */
+static hs_timer_t *hs_timer_expire_list_pop(hs_timer_expire_list_t *list)
+{
+    hs_timer_t *hs_timer = list->head;
+    if (hs_timer == NULL)
+    {
+        return NULL;
+    }
+
+    list->head = hs_timer->expire_next;
+    if (list->head == NULL)
+    {
+        list->tail = NULL;
+    }
+    hs_timer->expire_next = NULL;
+
+    return hs_timer;
+}
+
+/**
+ * @brief 将定时器的到期时间换算为引擎时间
+ *
+ * @note 分组成员的到期时间使用分组时钟，与 hs_timer_wake_ns() 相同，加上分组时钟的偏移后才能与其他定时器比较
+ *
+ * @param[in] hs_timer: 定时器对象
+ *
+ * @return 引擎时间 (单位: ns; UINT64_MAX: 分组已暂停)
+ */
+static uint64_t hs_timer_expire_list_key(const hs_timer_t *hs_timer)
+{
+    uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    if (hs_timer->group == NULL)
+    {
+        return deadline_ns;
+    }
+
+    uint64_t hold_ns = 0;
+    uint64_t offset_ns = 0;
+    if (hs_timer_group_read_clock(hs_timer->group, &hold_ns, &offset_ns))
+    {
+        return UINT64_MAX;
+    }
+
+    return (offset_ns > (UINT64_MAX - deadline_ns)) ? UINT64_MAX : (deadline_ns + offset_ns);
+}
+
+/**
+ * @brief 合并两个按到期时间排序的链表
+ *
+ * @note 按 expire_ns 比较，到期时间相同时 first 中的定时器在前
+ *
+ * @param[in,out] first : 链表头 (合并后不再使用)
+ * @param[in,out] second: 链表头 (合并后不再使用)
+ *
+ * @return 合并后的链表头
+ */
+static hs_timer_t *hs_timer_expire_list_merge(hs_timer_t *first, hs_timer_t *second)
+{
+    hs_timer_t *head = NULL;
+    hs_timer_t **tail = &head;
+    while ((first != NULL) && (second != NULL))
+    {
+        hs_timer_t **next = (second->expire_ns < first->expire_ns) ? &second : &first;
+        *tail = *next;
+        tail = &(*next)->expire_next;
+        *next = (*next)->expire_next;
+    }
+    *tail = (first != NULL) ? first : second;
+
+    return head;
+}
+
+/**
+ * @brief 按到期时间对链表排序
+ *
+ * @note 归并排序，到期时间相同的定时器保持原有顺序
+ *
+ * @param[in,out] head : 链表头
+ * @param[in]     count: 链表长度
+ *
+ * @return 排序后的链表头
+ */
+static hs_timer_t *hs_timer_expire_list_sort(hs_timer_t *head, const uint32_t count)
+{
+    if (count < 2)
+    {
+        return head;
+    }
+
+    uint32_t half = count / 2;
+    hs_timer_t *middle = head;
+    for (uint32_t i = 1; i < half; i++)
+    {
+        middle = middle->expire_next;
+    }
+    hs_timer_t *second = middle->expire_next;
+    middle->expire_next = NULL;
+
+    return hs_timer_expire_list_merge(hs_timer_expire_list_sort(head, half),
+                                      hs_timer_expire_list_sort(second, count - half));
+}
+
+/**
+ * @brief 将链表按到期时间合并到有序链表中
+ *
+ * @note 被合并的定时器在合并时换算排序键，已在有序链表中的定时器沿用入链时的排序键
+ *
+ * @param[in,out] list : 按到期时间排序的链表
+ * @param[in,out] other: 被合并的链表 (合并后清空)
+ *
+ * @return 合并的定时器数量
+ */
+static uint32_t hs_timer_expire_list_merge_sorted(hs_timer_expire_list_t *list, hs_timer_expire_list_t *other)
+{
+    uint32_t count = 0;
+    for (hs_timer_t *hs_timer = other->head; hs_timer != NULL; hs_timer = hs_timer->expire_next)
+    {
+        hs_timer->expire_ns = hs_timer_expire_list_key(hs_timer);
+        count++;
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    list->head = hs_timer_expire_list_merge(list->head, hs_timer_expire_list_sort(other->head, count));
+    list->tail = list->head;
+    while (list->tail->expire_next != NULL)
+    {
+        list->tail = list->tail->expire_next;
+    }
+
+    other->head = NULL;
+    other->tail = NULL;
+
+    return count;
+}
+
+/**
+ * @brief 将节拍转换为时间
+ *
+ * @param[in] engine: 引擎
+ * @param[in] tick  : 节拍
+ *
+ * @return 时间 (单位: ns; 超出范围时为 UINT64_MAX)
+ */
+static uint64_t hs_timer_engine_tick_to_ns(const hs_timer_engine_t *engine, const uint64_t tick)
+{
+    if (tick > (UINT64_MAX / engine->tick_ns))
+    {
+        return UINT64_MAX;
+    }
+
+    return tick * engine->tick_ns;
+}
+
+/**
+ * @brief 唤醒派发方
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_wake(hs_timer_engine_t *engine)
+{
+    // 已写入 eventfd 且派发方还没开始处理时，不需要重复写入
+    if (__atomic_exchange_n(&engine->wake_pending, true, __ATOMIC_SEQ_CST))
+    {
+        return;
+    }
+
+    uint64_t value = 1;
+    write(engine->event_fd, &value, sizeof(value));
+}
+
+/**
+ * @brief 创建 timerfd、eventfd 和同时监听两者的 epoll 描述符
+ *
+ * @note 已有描述符时 (fork() 后的子进程中)，新描述符复制到原来的编号上并关闭原描述符，
+ *       外部驱动模式下用户事件循环中登记的描述符编号不变
+ *
+ * @param[in,out] engine: 引擎 (没有描述符时为 -1)
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_timer_engine_open_fds(hs_timer_engine_t *engine)
+{
+    // CLOCK_MONOTONIC: 获取的时间为系统重启到现在的时间, 更改系统时间对其没有影响
+    // 描述符都设置为非阻塞，派发方被唤醒后统一读取，没有数据时不会阻塞
+    int fds[3] = {timerfd_create(engine->timer_clock_id, TFD_CLOEXEC | TFD_NONBLOCK),
+                  eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK), epoll_create1(EPOLL_CLOEXEC)};
+    int *slots[3] = {&engine->timer_fd, &engine->event_fd, &engine->poll_fd};
+    int ret = 0;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (fds[i] < 0)
+        {
+            ret = -1;
+        }
+        else if (*slots[i] < 0)
+        {
+            *slots[i] = fds[i];
+        }
+        else
+        {
+            if (dup3(fds[i], *slots[i], O_CLOEXEC) < 0)
+            {
+                ret = -1;
+            }
+            close(fds[i]);
+        }
+    }
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    struct epoll_event event = {0};
+    event.events = EPOLLIN;
+    event.data.fd = engine->timer_fd;
+    ret = epoll_ctl(engine->poll_fd, EPOLL_CTL_ADD, engine->timer_fd, &event);
+    event.data.fd = engine->event_fd;
+    if ((ret != 0) || (epoll_ctl(engine->poll_fd, EPOLL_CTL_ADD, engine->event_fd, &event) != 0))
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 清除 timerfd 和 eventfd 的可读状态
+ *
+ * @note 1. 两者都是非阻塞的，没有数据时返回 EAGAIN
+ *       2. timerfd 到期后不再设定，清除 armed_tick，引擎时钟落后于 timerfd 时钟时本轮处理结束后重新设定
+ *
+ * @param[in,out] engine: 引擎
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_timer_engine_clear_fds(hs_timer_engine_t *engine)
+{
+    uint64_t value = 0;
+    read(engine->event_fd, &value, sizeof(value));
+    ssize_t ret = read(engine->timer_fd, &value, sizeof(value));
+    if ((ret < 0) && (errno != EAGAIN) && (errno != EINTR))
+    {
+        return -1;
+    }
+    if (ret == (ssize_t)sizeof(value))
+    {
+        engine->armed_tick = HS_TIMER_WHEEL_NEVER;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 将定时器加入时间轮或堆
+ *
+ * @note 堆扩容失败时放入时间轮，超出时间轮范围的部分到期时重新加入
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象 (不在时间轮和堆中)
+ * @param[in]     expires : 到期节拍
+ */
+static void hs_timer_engine_queue_add(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t expires)
+{
+    // 分组成员按分组时间加入分组时间轮，分组第一次有成员时加入引擎的分组链表
+    hs_timer_group_t *group = hs_timer->group;
+    if (group != NULL)
+    {
+        if (!group->linked)
+        {
+            __atomic_add_fetch(&group->ref_count, 1, __ATOMIC_RELAXED);
+            group->linked = true;
+            group->prev = NULL;
+            group->next = engine->groups;
+            if (engine->groups != NULL)
+            {
+                engine->groups->prev = group;
+            }
+            engine->groups = group;
+        }
+        hs_timer_wheel_add(&group->wheel, &hs_timer->node, expires);
+
+        return;
+    }
+
+    bool use_heap = (engine->backend == E_HS_TIMER_ENGINE_BACKEND_HEAP);
+    if (engine->backend == E_HS_TIMER_ENGINE_BACKEND_HYBRID)
+    {
+        use_heap = (expires >= engine->wheel.tick) && ((expires - engine->wheel.tick) >= HS_TIMER_ENGINE_HYBRID_TICKS);
+    }
+
+    if (use_heap && (hs_timer_heap_add(&engine->heap, &hs_timer->heap_node, expires) == 0))
+    {
+        return;
+    }
+
+    hs_timer_wheel_add(&engine->wheel, &hs_timer->node, expires);
+}
+
+/**
+ * @brief 将定时器从时间轮或堆中移除
+ *
+ * @note 定时器不在其中时，直接返回
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_engine_queue_del(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if (hs_timer->group != NULL)
+    {
+        hs_timer_wheel_del(&hs_timer->group->wheel, &hs_timer->node);
+
+        return;
+    }
+
+    hs_timer_wheel_del(&engine->wheel, &hs_timer->node);
+    hs_timer_heap_del(&engine->heap, &hs_timer->heap_node);
+}
+
+/**
+ * @brief 获取定时器所在的时间轮
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in]     hs_timer: 定时器对象
+ *
+ * @return 分组成员: 分组时间轮
+ * @return 其它    : 引擎的时间轮 (wheel.tick 同时作为堆的当前节拍)
+ */
+static hs_timer_wheel_t *hs_timer_engine_wheel_of(hs_timer_engine_t *engine, const hs_timer_t *hs_timer)
+{
+    return (hs_timer->group != NULL) ? &hs_timer->group->wheel : &engine->wheel;
+}
+
+/**
+ * @brief 获取时间轮和堆中的定时器数量 (包括分组时间轮)
+ *
+ * @param[in] engine: 引擎
+ *
+ * @return 定时器数量
+ */
+static uint64_t hs_timer_engine_queue_count(const hs_timer_engine_t *engine)
+{
+    uint64_t count = engine->wheel.count + engine->heap.count;
+    for (const hs_timer_group_t *group = engine->groups; group != NULL; group = group->next)
+    {
+        count += group->wheel.count;
+    }
+
+    return count;
+}
+
+/**
+ * @brief 获取下一个需要处理的节拍
+ *
+ * @param[in] engine: 引擎
+ *
+ * @return 下一个需要处理的节拍 (HS_TIMER_WHEEL_NEVER: 没有定时器)
+ */
+static uint64_t hs_timer_engine_queue_next_tick(const hs_timer_engine_t *engine)
+{
+    uint64_t next_tick = hs_timer_wheel_next_tick(&engine->wheel);
+    uint64_t heap_tick = hs_timer_heap_next_tick(&engine->heap);
+
+    // 堆中已过期的节点在下一次推进时到期
+    if ((heap_tick != HS_TIMER_HEAP_NEVER) && (heap_tick < engine->wheel.tick))
+    {
+        heap_tick = engine->wheel.tick;
+    }
+    if (heap_tick < next_tick)
+    {
+        next_tick = heap_tick;
+    }
+
+    // 分组时间轮的节拍按分组时钟换算为引擎节拍，已暂停的分组不会到期
+    for (const hs_timer_group_t *group = engine->groups; group != NULL; group = group->next)
+    {
+        uint64_t hold_ns = 0;
+        uint64_t offset_ns = 0;
+        uint64_t group_tick = hs_timer_wheel_next_tick(&group->wheel);
+        if ((group_tick == HS_TIMER_WHEEL_NEVER) || hs_timer_group_read_clock(group, &hold_ns, &offset_ns))
+        {
+            continue;
+        }
+
+        uint64_t group_ns = hs_timer_engine_tick_to_ns(engine, group_tick);
+        uint64_t tick = (offset_ns > (UINT64_MAX - group_ns))
+                            ? HS_TIMER_WHEEL_NEVER
+                            : hs_timer_engine_ns_to_tick(engine, group_ns + offset_ns);
+        if (tick < next_tick)
+        {
+            next_tick = tick;
+        }
+    }
+
+    return next_tick;
+}
+
+/**
+ * @brief 将引擎时钟的时间换算为 timerfd 时钟的时间
+ *
+ * @note 1. 引擎时钟与 timerfd 时钟不同 (粗粒度时钟、TSC) 时，按两者当前的差值换算，TSC 相对 CLOCK_MONOTONIC 的漂移
+ *          每次设定时都会修正
+ *       2. 再推后 clock_lag_ns，timerfd 到期时引擎时钟已到达；仍未到达时 (如内核节拍被推迟) 下一轮按新的差值重新设定
+ *
+ * @param[in] engine     : 引擎
+ * @param[in] deadline_ns: 时间 (引擎时钟, 单位: ns)
+ *
+ * @return 时间 (timerfd 时钟, 单位: ns)
+ */
+static uint64_t hs_timer_engine_timer_ns(const hs_timer_engine_t *engine, const uint64_t deadline_ns)
+{
+    if ((engine->clock != E_HS_TIMER_ENGINE_CLOCK_COARSE) && (engine->clock != E_HS_TIMER_ENGINE_CLOCK_TSC))
+    {
+        return deadline_ns;
+    }
+
+    struct timespec now = {0};
+    clock_gettime(engine->timer_clock_id, &now);
+    uint64_t timer_now_ns = ((uint64_t)now.tv_sec * HS_TIMER_NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+    uint64_t engine_now_ns = hs_timer_engine_now_ns(engine);
+
+    uint64_t timer_ns = deadline_ns;
+    if (timer_now_ns >= engine_now_ns)
+    {
+        uint64_t skew_ns = (timer_now_ns - engine_now_ns) + engine->clock_lag_ns;
+        timer_ns = (timer_ns > (UINT64_MAX - skew_ns)) ? UINT64_MAX : (timer_ns + skew_ns);
+    }
+    else
+    {
+        uint64_t skew_ns = engine_now_ns - timer_now_ns;
+        timer_ns = (timer_ns > skew_ns) ? (timer_ns - skew_ns) : 0;
+        timer_ns = (timer_ns > (UINT64_MAX - engine->clock_lag_ns)) ? UINT64_MAX : (timer_ns + engine->clock_lag_ns);
+    }
+
+    // it_value 全为 0 表示关闭 timerfd
+    return (timer_ns != 0) ? timer_ns : 1;
+}
+
+/**
+ * @brief 按时间轮的下一个节拍设置 timerfd
+ *
+ * @note 同时更新派发方下一次唤醒的时间，提交方据此判断是否需要唤醒
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_program(hs_timer_engine_t *engine)
+{
+    // 还有超出派发预算的定时器时，下一个节拍继续派发
+    uint64_t next_tick = hs_timer_engine_queue_next_tick(engine);
+    if ((engine->ready.head != NULL) && (engine->wheel.tick < next_tick))
+    {
+        next_tick = engine->wheel.tick;
+    }
+    uint64_t deadline_ns = (next_tick == HS_TIMER_WHEEL_NEVER) ? UINT64_MAX
+                                                                : hs_timer_engine_tick_to_ns(engine, next_tick);
+    __atomic_store_n(&engine->wake_ns, deadline_ns, __ATOMIC_SEQ_CST);
+
+    if (next_tick == engine->armed_tick)
+    {
+        return;
+    }
+
+    // it_value 全为 0 时关闭 timerfd
+    struct itimerspec timer_spec = {0};
+    if (next_tick != HS_TIMER_WHEEL_NEVER)
+    {
+        // 自旋模式下提前醒来，剩余的时间由派发线程自旋等待
+        uint64_t timer_ns = hs_timer_engine_timer_ns(engine, deadline_ns);
+        timer_ns = (timer_ns > engine->spin_ns) ? (timer_ns - engine->spin_ns) : 1;
+        timer_spec.it_value.tv_sec = (time_t)(timer_ns / HS_TIMER_NSEC_PER_SEC);
+        timer_spec.it_value.tv_nsec = (long)(timer_ns % HS_TIMER_NSEC_PER_SEC);
+    }
+
+    if (timerfd_settime(engine->timer_fd, TFD_TIMER_ABSTIME, &timer_spec, NULL) == 0)
+    {
+        engine->armed_tick = next_tick;
+    }
+}
+
+/**
+ * @brief 释放定时器
+ *
+ * @note 调用前必须确认定时器不在命令队列中，且不在到期处理中
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_engine_release(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    hs_timer_engine_queue_del(engine, hs_timer);
+    hs_timer_engine_free_timer(engine, hs_timer);
+}
+
+/**
+ * @brief 是否没有正在进行的调用
+ *
+ * @note 有调用未结束时置位 HS_TIMER_IN_FLIGHT_PARKED，最后离开的调用提交 HS_TIMER_CMD_UNPARK 后派发方再次检查
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return true : 没有，可以释放
+ * @return false: 有调用未结束或解除请求尚未取走
+ */
+static bool hs_timer_engine_idle(hs_timer_t *hs_timer)
+{
+    uint32_t in_flight = __atomic_load_n(&hs_timer->in_flight, __ATOMIC_SEQ_CST);
+    while (in_flight != 0)
+    {
+        if ((in_flight & (HS_TIMER_IN_FLIGHT_PARKED | HS_TIMER_IN_FLIGHT_UNPARKING)) != 0)
+        {
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&hs_timer->in_flight, &in_flight, in_flight | HS_TIMER_IN_FLIGHT_PARKED,
+                                        false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 是否可以释放请求销毁的定时器
+ *
+ * @note 1. 请求销毁的一方切换状态后还要提交命令，取走其销毁请求之前不能释放 (否则对象可能在提交前被复用)
+ *       2. 到期处理自动销毁时，已通过状态检查的其它调用可能还要访问定时器，等这些调用结束后再释放
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return true : 可以
+ * @return false: 不可以 (引擎之后还会访问该定时器)
+ */
+static bool hs_timer_engine_can_release(hs_timer_t *hs_timer)
+{
+    return (hs_timer->destroy_acked && !hs_timer->in_dispatch &&
+            (__atomic_load_n(&hs_timer->cmd_state, __ATOMIC_SEQ_CST) == 0) && hs_timer_engine_idle(hs_timer));
+}
+
+/**
+ * @brief 取走解除推迟释放的请求
+ *
+ * @note 解除后仍有调用未结束时重新推迟，由这些调用中最后离开的一个再次提交
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_engine_unpark(hs_timer_t *hs_timer)
+{
+    uint32_t in_flight = __atomic_load_n(&hs_timer->in_flight, __ATOMIC_SEQ_CST);
+    uint32_t next = 0;
+    do
+    {
+        uint32_t count = in_flight & HS_TIMER_IN_FLIGHT_COUNT;
+        next = (count == 0) ? 0 : (count | HS_TIMER_IN_FLIGHT_PARKED);
+    } while (!__atomic_compare_exchange_n(&hs_timer->in_flight, &in_flight, next, false, __ATOMIC_SEQ_CST,
+                                          __ATOMIC_SEQ_CST));
+}
+
+/**
+ * @brief 按定时器的最新状态更新时间轮
+ *
+ * @note 1. 请求销毁且不在到期处理中的定时器直接释放
+ *       2. 只有启动序号变化时才重新加入时间轮，重复提交不会重复启动
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+static void hs_timer_engine_reconcile(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if (__atomic_exchange_n(&hs_timer->completed, false, __ATOMIC_ACQUIRE))
+    {
+        hs_timer->in_dispatch = false;
+    }
+
+    // 下面按最新状态移除或重新加入，不再是墓碑
+    hs_timer_engine_clear_tombstone(engine, hs_timer);
+
+    hs_timer_status_e status = __atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE);
+    if (status == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+    {
+        hs_timer_engine_queue_del(engine, hs_timer);
+        if (hs_timer_engine_can_release(hs_timer))
+        {
+            hs_timer_engine_release(engine, hs_timer);
+        }
+
+        return;
+    }
+
+    if (status != E_HS_TIMER_STATUS_RUNNING)
+    {
+        hs_timer->expire_pending = false;
+        hs_timer_engine_queue_del(engine, hs_timer);
+
+        return;
+    }
+
+    // 到期处理期间再次到期，上一次处理结束后立即重新执行
+    if (hs_timer->expire_pending && !hs_timer->in_dispatch)
+    {
+        hs_timer->expire_pending = false;
+        hs_timer->in_dispatch = true;
+        hs_timer_expire_list_push(&engine->expired, hs_timer);
+    }
+
+    uint32_t arm_seq = __atomic_load_n(&hs_timer->arm_seq, __ATOMIC_ACQUIRE);
+    if (arm_seq == hs_timer->applied_seq)
+    {
+        return;
+    }
+    hs_timer->applied_seq = arm_seq;
+
+    uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    uint64_t slack_ns = __atomic_load_n(&hs_timer->slack_ns, __ATOMIC_RELAXED);
+
+    hs_timer_engine_queue_del(engine, hs_timer);
+
+    // 时间轮为空时，当前节拍可能因长时间空闲而落后，先对齐到当前时间 (分组时间轮对齐到当前分组时间)
+    hs_timer_wheel_t *wheel = hs_timer_engine_wheel_of(engine, hs_timer);
+    if (wheel->count == 0)
+    {
+        uint64_t now_ns = (hs_timer->group != NULL) ? hs_timer_group_now_ns(hs_timer->group)
+                                                    : hs_timer_engine_now_ns(engine);
+        wheel->tick = now_ns / engine->tick_ns;
+    }
+
+    hs_timer_engine_queue_add(engine, hs_timer, hs_timer_engine_apply_slack(engine, deadline_ns, slack_ns));
+}
+
+/**
+ * @brief 占用定时器的命令队列状态
+ *
+ * @note 1. 不在队列中时占用入队权，由调用方链入队列
+ *       2. 已在队列中时只更新标志，派发方清除标志后才读取状态，能看到本次写入的状态
+ *       3. 正在链入时置位 HS_TIMER_CMD_WAKE，由链入方代为唤醒派发方
+ *       4. push_flags 中的 HS_TIMER_CMD_DESTROY 和 HS_TIMER_CMD_UNPARK 无论是否占用入队权都会置位
+ *
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     push_flags: 占用入队权时额外置位的标志
+ * @param[in]     wake_ns   : 同 hs_timer_engine_submit()
+ *
+ * @return 占用前的状态
+ */
+static uint32_t hs_timer_engine_claim(hs_timer_t *hs_timer, const uint32_t push_flags, const uint64_t wake_ns)
+{
+    uint32_t state = __atomic_load_n(&hs_timer->cmd_state, __ATOMIC_RELAXED);
+    uint32_t destroy = push_flags & (HS_TIMER_CMD_DESTROY | HS_TIMER_CMD_UNPARK);
+    uint32_t next = 0;
+
+    do
+    {
+        if ((state & HS_TIMER_CMD_QUEUED) == 0)
+        {
+            next = HS_TIMER_CMD_QUEUED | push_flags;
+        }
+        else if (((state & HS_TIMER_CMD_LINKED) != 0) || (wake_ns == HS_TIMER_ENGINE_WAKE_NONE))
+        {
+            next = state | destroy;
+        }
+        else
+        {
+            next = state | HS_TIMER_CMD_WAKE | destroy;
+        }
+    } while (!__atomic_compare_exchange_n(&hs_timer->cmd_state, &state, next, true, __ATOMIC_SEQ_CST,
+                                          __ATOMIC_RELAXED));
+
+    return state;
+}
+
+/**
+ * @brief 将定时器链表加入命令队列
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in,out] head  : 链表头 (通过 cmd_next 连接)
+ * @param[in,out] tail  : 链表尾
+ */
+static void hs_timer_engine_push(hs_timer_engine_t *engine, hs_timer_t *head, hs_timer_t *tail)
+{
+    hs_timer_t *old_head = __atomic_load_n(&engine->cmd_head, __ATOMIC_RELAXED);
+    do
+    {
+        tail->cmd_next = old_head;
+    } while (!__atomic_compare_exchange_n(&engine->cmd_head, &old_head, head, true, __ATOMIC_SEQ_CST,
+                                          __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief 检查命令队列中的定时器是否已链入
+ *
+ * @note 提交方链入后才置位 HS_TIMER_CMD_LINKED，之前还会读写标志，派发方不能处理；提交方可能在两者之间被抢占，
+ *       派发方不等待，置位 HS_TIMER_CMD_WAKE 后由提交方置位 HS_TIMER_CMD_LINKED 时唤醒派发方再处理
+ *
+ * @param[in,out] hs_timer: 已从命令队列中取出的定时器对象
+ *
+ * @return true : 已链入，可以处理
+ * @return false: 未链入，提交方链入后会唤醒派发方
+ */
+static bool hs_timer_engine_linked(hs_timer_t *hs_timer)
+{
+    uint32_t state = __atomic_load_n(&hs_timer->cmd_state, __ATOMIC_ACQUIRE);
+    while ((state & HS_TIMER_CMD_LINKED) == 0)
+    {
+        if (__atomic_compare_exchange_n(&hs_timer->cmd_state, &state, state | HS_TIMER_CMD_WAKE, true,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 处理命令队列中的全部定时器
+ *
+ * @note 上一次未链入的定时器先处理，仍未链入的留到下一次
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_drain(hs_timer_engine_t *engine)
+{
+    hs_timer_t *hs_timer = __atomic_exchange_n(&engine->cmd_head, NULL, __ATOMIC_ACQUIRE);
+
+    // 栈中是后提交的在前，反转后按提交顺序处理
+    hs_timer_t *fifo = NULL;
+    while (hs_timer != NULL)
+    {
+        hs_timer_t *next = hs_timer->cmd_next;
+        hs_timer->cmd_next = fifo;
+        fifo = hs_timer;
+        hs_timer = next;
+    }
+
+    if (engine->cmd_retry_head != NULL)
+    {
+        engine->cmd_retry_tail->cmd_next = fifo;
+        fifo = engine->cmd_retry_head;
+        engine->cmd_retry_head = NULL;
+        engine->cmd_retry_tail = NULL;
+    }
+
+    while (fifo != NULL)
+    {
+        // 清除入队标志后 cmd_next 可能被提交方改写，先取出下一个；标志必须在读取状态前清除，之后的提交会重新入队
+        hs_timer_t *next = fifo->cmd_next;
+
+        // 入队标志未清除，提交方不会改写 cmd_next，可以借用它连接重试链表
+        if (!hs_timer_engine_linked(fifo))
+        {
+            fifo->cmd_next = NULL;
+            if (engine->cmd_retry_tail != NULL)
+            {
+                engine->cmd_retry_tail->cmd_next = fifo;
+            }
+            else
+            {
+                engine->cmd_retry_head = fifo;
+            }
+            engine->cmd_retry_tail = fifo;
+            fifo = next;
+
+            continue;
+        }
+
+        uint32_t state = __atomic_exchange_n(&fifo->cmd_state, 0, __ATOMIC_SEQ_CST);
+        if ((state & HS_TIMER_CMD_DESTROY) != 0)
+        {
+            fifo->destroy_acked = true;
+        }
+        if ((state & HS_TIMER_CMD_UNPARK) != 0)
+        {
+            hs_timer_engine_unpark(fifo);
+        }
+        hs_timer_engine_reconcile(engine, fifo);
+        fifo = next;
+    }
+}
+
+/**
+ * @brief 收集到期的定时器
+ *
+ * @note 1. 到期处理尚未结束的定时器只做标记，等上一次处理结束后再执行，保证同一定时器不会并发执行
+ *       2. 时间轮已推进到本轮的当前节拍之后 (wheel.tick 为下一个待处理的节拍)
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 已从时间轮或堆中移除的定时器对象
+ */
+static void hs_timer_engine_collect(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    hs_timer_status_e status = __atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE);
+    if (hs_timer_engine_clear_tombstone(engine, hs_timer) && (status == E_HS_TIMER_STATUS_PAUSED))
+    {
+        hs_timer_counter_add(&engine->tombstone_dropped, 1);
+    }
+
+    if (status == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+    {
+        if (hs_timer_engine_can_release(hs_timer))
+        {
+            hs_timer_engine_free_timer(engine, hs_timer);
+        }
+
+        return;
+    }
+
+    // 已暂停，或已重新启动但命令尚未处理 (以新的到期时间为准)
+    if ((status != E_HS_TIMER_STATUS_RUNNING) ||
+        (__atomic_load_n(&hs_timer->arm_seq, __ATOMIC_ACQUIRE) != hs_timer->applied_seq))
+    {
+        return;
+    }
+
+    // 到期时间已被推迟 (hs_timer_postpone()) 或超出时间轮范围，按最新的到期时间重新加入
+    uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+    if (hs_timer_engine_ns_to_tick(engine, deadline_ns) >= hs_timer_engine_wheel_of(engine, hs_timer)->tick)
+    {
+        uint64_t slack_ns = __atomic_load_n(&hs_timer->slack_ns, __ATOMIC_RELAXED);
+        hs_timer_engine_queue_add(engine, hs_timer, hs_timer_engine_apply_slack(engine, deadline_ns, slack_ns));
+
+        return;
+    }
+
+    if (hs_timer->in_dispatch)
+    {
+        hs_timer->expire_pending = true;
+
+        return;
+    }
+
+    hs_timer->in_dispatch = true;
+    hs_timer_expire_list_push(&engine->expired, hs_timer);
+}
+
+/**
+ * @brief 收集时间轮中到期的定时器
+ *
+ * @param[in,out] node: 时间轮节点
+ * @param[in,out] arg : 引擎
+ */
+static void hs_timer_engine_collect_wheel(hs_timer_wheel_node_t *node, void *arg)
+{
+    hs_timer_engine_collect((hs_timer_engine_t *)arg, HS_TIMER_CONTAINER_OF(node, hs_timer_t, node));
+}
+
+/**
+ * @brief 收集堆中到期的定时器
+ *
+ * @param[in,out] node: 堆节点
+ * @param[in,out] arg : 引擎
+ */
+static void hs_timer_engine_collect_heap(hs_timer_heap_node_t *node, void *arg)
+{
+    hs_timer_engine_collect((hs_timer_engine_t *)arg, HS_TIMER_CONTAINER_OF(node, hs_timer_t, heap_node));
+}
+
+/**
+ * @brief 执行器任务: 执行一个定时器的到期处理
+ *
+ * @param[in,out] arg: 定时器对象
+ */
+static void hs_timer_engine_task(void *arg)
+{
+    hs_timer_t *hs_timer = (hs_timer_t *)arg;
+
+    // 到期处理结束后定时器可能已被释放，先取出引擎
+    hs_timer_engine_t *engine = hs_timer->engine;
+    hs_timer_expire(hs_timer);
+    __atomic_sub_fetch(&engine->task_count, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 取出下一个按预算派发的定时器
+ *
+ * @note 1. 等待期间被暂停的定时器不再派发；到期时间被推迟的定时器按新的到期时间重新加入时间轮
+ *       2. 请求销毁的定时器照常取出，由到期处理流程交给派发方释放
+ *       3. 取出的定时器已不在时间轮或堆中
+ *
+ * @param[in,out] engine: 引擎
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL (没有等待派发的定时器)
+ */
+static hs_timer_t *hs_timer_engine_ready_pop(hs_timer_engine_t *engine)
+{
+    hs_timer_t *hs_timer = NULL;
+    while ((hs_timer = hs_timer_expire_list_pop(&engine->ready)) != NULL)
+    {
+        __atomic_store_n(&engine->ready_count, __atomic_load_n(&engine->ready_count, __ATOMIC_RELAXED) - 1,
+                         __ATOMIC_RELAXED);
+
+        hs_timer_status_e status = __atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE);
+        if (status == E_HS_TIMER_STATUS_REQUEST_DESTROY)
+        {
+            return hs_timer;
+        }
+
+        if (status != E_HS_TIMER_STATUS_RUNNING)
+        {
+            hs_timer->in_dispatch = false;
+            hs_timer->expire_pending = false;
+            if (hs_timer_engine_clear_tombstone(engine, hs_timer))
+            {
+                hs_timer_counter_add(&engine->tombstone_dropped, 1);
+            }
+
+            continue;
+        }
+
+        uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED);
+        if (hs_timer_engine_ns_to_tick(engine, deadline_ns) >= hs_timer_engine_wheel_of(engine, hs_timer)->tick)
+        {
+            uint64_t slack_ns = __atomic_load_n(&hs_timer->slack_ns, __ATOMIC_RELAXED);
+            hs_timer->in_dispatch = false;
+            hs_timer_engine_queue_del(engine, hs_timer);
+            hs_timer_engine_queue_add(engine, hs_timer, hs_timer_engine_apply_slack(engine, deadline_ns, slack_ns));
+
+            continue;
+        }
+
+        // 等待期间重新启动的定时器已按新的到期时间加入时间轮，派发前移除，否则之后会再次到期
+        hs_timer_engine_queue_del(engine, hs_timer);
+
+        return hs_timer;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 取出链表中的高优先级定时器
+ *
+ * @param[in,out] list: 链表 (取出后只剩普通定时器，保持原有顺序)
+ * @param[out]    high: 高优先级定时器 (保持原有顺序)
+ */
+static void hs_timer_expire_list_take_high(hs_timer_expire_list_t *list, hs_timer_expire_list_t *high)
+{
+    hs_timer_expire_list_t normal = {NULL, NULL};
+    hs_timer_t *hs_timer = NULL;
+    while ((hs_timer = hs_timer_expire_list_pop(list)) != NULL)
+    {
+        if (__atomic_load_n(&hs_timer->priority, __ATOMIC_RELAXED) == E_HS_TIMER_PRIORITY_HIGH)
+        {
+            hs_timer_expire_list_push(high, hs_timer);
+        }
+        else
+        {
+            hs_timer_expire_list_push(&normal, hs_timer);
+        }
+    }
+    *list = normal;
+}
+
+/**
+ * @brief 取出下一个要派发的定时器
+ *
+ * @note 1. 高优先级定时器最先取出，不受派发预算限制
+ *       2. 设置了派发预算时，按到期时间从 ready 中取出，超出本次唤醒的预算后不再取出
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in,out] high  : 本轮到期的高优先级定时器
+ * @param[in,out] list  : 本轮到期的普通定时器 (未设置派发预算时使用)
+ *
+ * @return 成功: 定时器对象
+ * @return 失败: NULL (没有可以派发的定时器)
+ */
+static hs_timer_t *hs_timer_engine_next(hs_timer_engine_t *engine, hs_timer_expire_list_t *high,
+                                        hs_timer_expire_list_t *list)
+{
+    if (high->head != NULL)
+    {
+        return hs_timer_expire_list_pop(high);
+    }
+
+    if ((engine->dispatch_budget == 0) && (engine->dispatch_budget_ns == 0))
+    {
+        return hs_timer_expire_list_pop(list);
+    }
+
+    if ((engine->dispatch_budget != 0) && (engine->round_count >= engine->dispatch_budget))
+    {
+        return NULL;
+    }
+
+    if ((engine->dispatch_budget_ns != 0) && (engine->round_count > 0) &&
+        (hs_timer_engine_now_ns(engine) - engine->round_start_ns >= engine->dispatch_budget_ns))
+    {
+        return NULL;
+    }
+
+    return hs_timer_engine_ready_pop(engine);
+}
+
+/**
+ * @brief 将到期的定时器交给回调工作线程
+ *
+ * @param[in,out] engine   : 引擎
+ * @param[in,out] work_list: 工作队列 (由引擎互斥锁保护)
+ * @param[in,out] work_cond: 工作队列条件变量
+ * @param[in,out] list     : 到期的定时器 (交出后清空; 为空时直接返回)
+ */
+static void hs_timer_engine_post(hs_timer_engine_t *engine, hs_timer_expire_list_t *work_list,
+                                 pthread_cond_t *work_cond, hs_timer_expire_list_t *list)
+{
+    if (list->head == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+    hs_timer_expire_list_splice(work_list, list);
+    pthread_cond_broadcast(work_cond);
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+/**
+ * @brief 执行一个到期的定时器 (或一次批量回调)
+ *
+ * @param[in,out] engine   : 引擎
+ * @param[in,out] hs_timer : 到期的定时器 (批量回调时为首个定时器)
+ * @param[in,out] work     : 本轮交给回调工作线程的定时器
+ * @param[in,out] high_work: 本轮交给高优先级回调工作线程的定时器
+ */
+static void hs_timer_engine_execute(hs_timer_engine_t *engine, hs_timer_t *hs_timer, hs_timer_expire_list_t *work,
+                                    hs_timer_expire_list_t *high_work)
+{
+    HS_TIMER_TRACE(DISPATCH, hs_timer, __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_RELAXED));
+
+    bool is_high = (__atomic_load_n(&hs_timer->priority, __ATOMIC_RELAXED) == E_HS_TIMER_PRIORITY_HIGH);
+    if (engine->executor_submit != NULL)
+    {
+        __atomic_add_fetch(&engine->task_count, 1, __ATOMIC_RELAXED);
+        if (engine->executor_submit(hs_timer_engine_task, hs_timer, engine->executor_ctx) != 0)
+        {
+            hs_timer_engine_task(hs_timer);
+        }
+    }
+    else if (is_high && (engine->high_worker_count > 0))
+    {
+        hs_timer_expire_list_push(high_work, hs_timer);
+    }
+    else if (engine->worker_count > 0)
+    {
+        hs_timer_expire_list_push(work, hs_timer);
+    }
+    else
+    {
+        // 到期处理结束后通过命令队列通知派发方，这里不会释放定时器
+        hs_timer_expire(hs_timer);
+    }
+}
+
+/**
+ * @brief 执行本轮到期的定时器
+ *
+ * @note 1. 配置了执行器时，每个到期的定时器作为一个任务提交给执行器
+ *       2. 有回调工作线程时，到期的定时器交给工作线程执行；否则直接在当前线程执行
+ *       3. 设置了派发预算时，先按到期时间合并到 ready 中，超出预算的留到下一个节拍
+ *       4. 高优先级定时器最先派发，有高优先级回调工作线程时交给这些线程执行
+ *       5. 分组设置了批量回调时，本轮到期的成员按到期先后连接起来，全部取出后作为一次批量回调执行
+ *
+ * @param[in,out] engine: 引擎
+ *
+ * @return 派发的定时器数量
+ */
+static uint32_t hs_timer_engine_dispatch(hs_timer_engine_t *engine)
+{
+    hs_timer_expire_list_t list = engine->expired;
+    hs_timer_expire_list_t high = {NULL, NULL};
+    engine->expired.head = NULL;
+    engine->expired.tail = NULL;
+    hs_timer_expire_list_take_high(&list, &high);
+    if ((engine->dispatch_budget != 0) || (engine->dispatch_budget_ns != 0))
+    {
+        hs_timer_counter_add(&engine->ready_count, hs_timer_expire_list_merge_sorted(&engine->ready, &list));
+
+        hs_timer_expire_list_t sorted = {NULL, NULL};
+        hs_timer_expire_list_merge_sorted(&sorted, &high);
+        high = sorted;
+    }
+
+    uint32_t count = 0;
+    hs_timer_expire_list_t work = {NULL, NULL};
+    hs_timer_expire_list_t high_work = {NULL, NULL};
+    hs_timer_group_t *groups = NULL;
+    hs_timer_t *hs_timer = NULL;
+    while ((hs_timer = hs_timer_engine_next(engine, &high, &list)) != NULL)
+    {
+        bool is_high = (__atomic_load_n(&hs_timer->priority, __ATOMIC_RELAXED) == E_HS_TIMER_PRIORITY_HIGH);
+        count++;
+        if (!is_high)
+        {
+            // 高优先级定时器已全部取出，先交给高优先级回调工作线程，再处理普通定时器
+            hs_timer_engine_post(engine, &engine->high_work_list, &engine->high_work_cond, &high_work);
+            engine->round_count++;
+        }
+
+        hs_timer->batch_leader = NULL;
+        hs_timer->batch_group = NULL;
+        hs_timer_group_t *group = hs_timer->group;
+        if ((group == NULL) || (group->batch_cb == NULL))
+        {
+            hs_timer_engine_execute(engine, hs_timer, &work, &high_work);
+
+            continue;
+        }
+
+        // 批量回调的首个定时器记录分组，执行时沿 batch_next 取出全部成员
+        if (group->batch_head == NULL)
+        {
+            group->batch_head = hs_timer;
+            group->batch_link = groups;
+            groups = group;
+            hs_timer->batch_group = group;
+        }
+        else
+        {
+            group->batch_tail->batch_next = hs_timer;
+        }
+        group->batch_tail = hs_timer;
+        hs_timer->batch_next = NULL;
+        hs_timer->batch_leader = group->batch_head;
+    }
+
+    while (groups != NULL)
+    {
+        hs_timer_group_t *group = groups;
+        groups = group->batch_link;
+        hs_timer = group->batch_head;
+        group->batch_head = NULL;
+        group->batch_tail = NULL;
+        group->batch_link = NULL;
+        hs_timer_engine_execute(engine, hs_timer, &work, &high_work);
+    }
+
+    hs_timer_engine_post(engine, &engine->high_work_list, &engine->high_work_cond, &high_work);
+    hs_timer_engine_post(engine, &engine->work_list, &engine->work_cond, &work);
+
+    return count;
+}
+
+/**
+ * @brief 移除已暂停的定时器
+ *
+ * @note 1. 已暂停的定时器不会再到期，普通暂停的在命令处理时移除，这里移除的都是延迟取消留下的墓碑
+ *       2. 请求销毁的定时器需要在命令处理时释放，保留
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 时间轮或堆中的定时器对象
+ *
+ * @return true : 移除
+ * @return false: 保留
+ */
+static bool hs_timer_engine_purge(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if (__atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE) != E_HS_TIMER_STATUS_PAUSED)
+    {
+        return false;
+    }
+
+    hs_timer_engine_clear_tombstone(engine, hs_timer);
+    hs_timer_counter_add(&engine->compacted_count, 1);
+
+    return true;
+}
+
+/**
+ * @brief 判断是否移除时间轮中的定时器
+ *
+ * @param[in,out] node: 时间轮节点
+ * @param[in,out] arg : 引擎
+ *
+ * @return true : 移除
+ * @return false: 保留
+ */
+static bool hs_timer_engine_purge_wheel(hs_timer_wheel_node_t *node, void *arg)
+{
+    return hs_timer_engine_purge((hs_timer_engine_t *)arg, HS_TIMER_CONTAINER_OF(node, hs_timer_t, node));
+}
+
+/**
+ * @brief 判断是否移除堆中的定时器
+ *
+ * @param[in,out] node: 堆节点
+ * @param[in,out] arg : 引擎
+ *
+ * @return true : 移除
+ * @return false: 保留
+ */
+static bool hs_timer_engine_purge_heap(hs_timer_heap_node_t *node, void *arg)
+{
+    return hs_timer_engine_purge((hs_timer_engine_t *)arg, HS_TIMER_CONTAINER_OF(node, hs_timer_t, heap_node));
+}
+
+/**
+ * @brief 墓碑较多时压缩时间轮和堆
+ *
+ * @note 墓碑数量不少于 HS_TIMER_ENGINE_COMPACT_MIN 且达到时间轮和堆中定时器的 compact_percent% 时，一次移除全部墓碑
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_compact(hs_timer_engine_t *engine)
+{
+    if (engine->compact_percent == 0)
+    {
+        return;
+    }
+
+    uint64_t tombstone_count = __atomic_load_n(&engine->tombstone_count, __ATOMIC_RELAXED);
+    if ((tombstone_count < HS_TIMER_ENGINE_COMPACT_MIN) ||
+        ((tombstone_count * 100) < (hs_timer_engine_queue_count(engine) * engine->compact_percent)))
+    {
+        return;
+    }
+
+    hs_timer_wheel_purge(&engine->wheel, hs_timer_engine_purge_wheel, engine);
+    hs_timer_heap_purge(&engine->heap, hs_timer_engine_purge_heap, engine);
+    for (hs_timer_group_t *group = engine->groups; group != NULL; group = group->next)
+    {
+        hs_timer_wheel_purge(&group->wheel, hs_timer_engine_purge_wheel, engine);
+    }
+    hs_timer_counter_add(&engine->compact_count, 1);
+}
+
+/**
+ * @brief 将分组从引擎的分组链表中移除
+ *
+ * @note 释放分组链表持有的引用，之后不能再访问分组
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in,out] group : 分组时间轮为空的分组
+ */
+static void hs_timer_engine_unlink_group(hs_timer_engine_t *engine, hs_timer_group_t *group)
+{
+    if (group->prev != NULL)
+    {
+        group->prev->next = group->next;
+    }
+    else
+    {
+        engine->groups = group->next;
+    }
+    if (group->next != NULL)
+    {
+        group->next->prev = group->prev;
+    }
+    group->prev = NULL;
+    group->next = NULL;
+    group->linked = false;
+    hs_timer_group_unref(group);
+}
+
+/**
+ * @brief 按各分组的时钟推进分组时间轮
+ *
+ * @note 1. 已暂停的分组不推进，成员留在分组时间轮中，暂停和恢复都不需要逐个处理成员
+ *       2. 分组时间轮为空时移除分组，有成员重新启动时再加入
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in]     now_ns: 当前时间 (引擎时钟, 单位: ns)
+ */
+static void hs_timer_engine_advance_groups(hs_timer_engine_t *engine, const uint64_t now_ns)
+{
+    hs_timer_group_t *next = NULL;
+    for (hs_timer_group_t *group = engine->groups; group != NULL; group = next)
+    {
+        next = group->next;
+
+        uint64_t hold_ns = 0;
+        uint64_t offset_ns = 0;
+        if ((group->wheel.count != 0) && !hs_timer_group_read_clock(group, &hold_ns, &offset_ns))
+        {
+            uint64_t group_ns = hs_timer_group_time_ns(hold_ns, offset_ns, now_ns);
+            hs_timer_wheel_advance(&group->wheel, group_ns / engine->tick_ns, hs_timer_engine_collect_wheel, engine);
+        }
+
+        if (group->wheel.count == 0)
+        {
+            hs_timer_engine_unlink_group(engine, group);
+        }
+    }
+}
+
+/**
+ * @brief 处理命令并执行到期的定时器
+ *
+ * @note 1. 只能由派发方调用，时间轮只在这里修改，不需要加锁
+ *       2. 设置下一次唤醒时间后命令队列仍不为空时继续处理，保证不会漏掉唤醒
+ *
+ * @param[in,out] engine: 引擎
+ *
+ * @return 到期的定时器数量
+ */
+static uint32_t hs_timer_engine_run(hs_timer_engine_t *engine)
+{
+    uint32_t count = 0;
+    pthread_mutex_lock(&engine->run_mutex);
+    hs_timer_engine_t *prev_engine = s_current_engine;
+    hs_timer_engine_stats_block_t *prev_block = s_stats_block;
+    s_current_engine = engine;
+    s_stats_block = &engine->stats_blocks[0];
+    hs_timer_counter_add(&engine->wakeup_count, 1);
+    engine->round_count = 0;
+    engine->round_start_ns = (engine->dispatch_budget_ns != 0) ? hs_timer_engine_now_ns(engine) : 0;
+
+    // 本轮开始前提交的同步请求，本轮结束时完成
+    pthread_mutex_lock(&engine->mutex);
+    uint64_t sync_request = engine->sync_request;
+    pthread_mutex_unlock(&engine->mutex);
+
+    do
+    {
+        __atomic_store_n(&engine->wake_pending, false, __ATOMIC_SEQ_CST);
+        hs_timer_engine_drain(engine);
+
+        uint64_t now_ns = hs_timer_engine_now_ns(engine);
+        uint64_t now_tick = now_ns / engine->tick_ns;
+        hs_timer_wheel_advance(&engine->wheel, now_tick, hs_timer_engine_collect_wheel, engine);
+        hs_timer_heap_advance(&engine->heap, now_tick, hs_timer_engine_collect_heap, engine);
+        hs_timer_engine_advance_groups(engine, now_ns);
+        count += hs_timer_engine_dispatch(engine);
+        hs_timer_engine_compact(engine);
+
+        hs_timer_engine_program(engine);
+    } while (__atomic_load_n(&engine->cmd_head, __ATOMIC_SEQ_CST) != NULL);
+
+    __atomic_store_n(&engine->active_count, hs_timer_engine_queue_count(engine), __ATOMIC_RELAXED);
+    s_current_engine = prev_engine;
+    s_stats_block = prev_block;
+
+    pthread_mutex_lock(&engine->mutex);
+    if (engine->sync_done < sync_request)
+    {
+        engine->sync_done = sync_request;
+        pthread_cond_broadcast(&engine->sync_cond);
+    }
+    pthread_mutex_unlock(&engine->mutex);
+    pthread_mutex_unlock(&engine->run_mutex);
+
+    return count;
+}
+
+/**
+ * @brief 等待派发方处理完已提交的命令
+ *
+ * @note 外部驱动模式下在当前线程处理，持有派发互斥锁并作为派发方，与事件循环中的 hs_timer_engine_process_expired() 互斥
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_sync(hs_timer_engine_t *engine)
+{
+    if (engine->mode == E_HS_TIMER_ENGINE_MODE_EXTERNAL)
+    {
+        pthread_mutex_lock(&engine->run_mutex);
+        hs_timer_engine_t *prev_engine = s_current_engine;
+        hs_timer_engine_stats_block_t *prev_block = s_stats_block;
+        s_current_engine = engine;
+        s_stats_block = &engine->stats_blocks[0];
+
+        hs_timer_engine_drain(engine);
+
+        s_current_engine = prev_engine;
+        s_stats_block = prev_block;
+        pthread_mutex_unlock(&engine->run_mutex);
+
+        return;
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+    uint64_t request = ++engine->sync_request;
+    pthread_mutex_unlock(&engine->mutex);
+
+    hs_timer_engine_wake(engine);
+
+    pthread_mutex_lock(&engine->mutex);
+    while (engine->sync_done < request)
+    {
+        pthread_cond_wait(&engine->sync_cond, &engine->mutex);
+    }
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+/**
+ * @brief 降低自旋等待时的功耗和对同核超线程的影响
+ */
+static inline void hs_timer_engine_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief 提前醒来后自旋等待到期
+ *
+ * @note 1. 只有距离下一次唤醒时间不超过 spin_ns 时才自旋 (timerfd 提前到期)，被命令唤醒时直接返回
+ *       2. 自旋期间有新命令、唤醒时间提前或引擎停止 (写入 eventfd) 时立即返回
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_spin(hs_timer_engine_t *engine)
+{
+    if (__atomic_load_n(&engine->wake_pending, __ATOMIC_SEQ_CST))
+    {
+        return;
+    }
+
+    uint64_t start_ns = hs_timer_engine_now_ns(engine);
+    uint64_t wake_ns = __atomic_load_n(&engine->wake_ns, __ATOMIC_SEQ_CST);
+    if ((wake_ns <= start_ns) || ((wake_ns - start_ns) > engine->spin_ns))
+    {
+        return;
+    }
+
+    uint64_t now_ns = start_ns;
+    while ((now_ns < __atomic_load_n(&engine->wake_ns, __ATOMIC_RELAXED)) &&
+           (__atomic_load_n(&engine->cmd_head, __ATOMIC_RELAXED) == NULL) &&
+           !__atomic_load_n(&engine->wake_pending, __ATOMIC_RELAXED))
+    {
+        hs_timer_engine_cpu_relax();
+        now_ns = hs_timer_engine_now_ns(engine);
+    }
+
+    hs_timer_counter_add(&engine->spin_count, 1);
+    hs_timer_counter_add(&engine->spin_total_ns, now_ns - start_ns);
+}
+
+/**
+ * @brief 引擎派发线程
+ *
+ * @param[in] arg: 引擎
+ *
+ * @return NULL
+ */
+static void *hs_timer_engine_thread(void *arg)
+{
+    hs_timer_engine_t *engine = (hs_timer_engine_t *)arg;
+
+    struct epoll_event events[2];
+    while (true)
+    {
+        if ((epoll_wait(engine->poll_fd, events, 2, -1) < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        hs_timer_engine_clear_fds(engine);
+
+        if (__atomic_load_n(&engine->stopping, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+
+        if (engine->spin_ns != 0)
+        {
+            hs_timer_engine_spin(engine);
+        }
+        hs_timer_engine_run(engine);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 执行工作队列中的到期定时器，直到引擎停止
+ *
+ * @param[in,out] engine   : 引擎
+ * @param[in,out] work_list: 工作队列 (由引擎互斥锁保护)
+ * @param[in,out] work_cond: 工作队列条件变量
+ */
+static void hs_timer_engine_work(hs_timer_engine_t *engine, hs_timer_expire_list_t *work_list,
+                                 pthread_cond_t *work_cond)
+{
+    pthread_mutex_lock(&engine->mutex);
+    s_stats_block = &engine->stats_blocks[++engine->worker_started];
+    while (true)
+    {
+        while ((work_list->head == NULL) && !__atomic_load_n(&engine->stopping, __ATOMIC_RELAXED))
+        {
+            pthread_cond_wait(work_cond, &engine->mutex);
+        }
+
+        hs_timer_t *hs_timer = hs_timer_expire_list_pop(work_list);
+        if (hs_timer == NULL)
+        {
+            break;
+        }
+
+        // 由 hs_timer_engine_complete() 清除
+        s_stats_block->running_generation = __atomic_load_n(&hs_timer->generation, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_stats_block->running, hs_timer, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&engine->mutex);
+        hs_timer_expire(hs_timer);
+        pthread_mutex_lock(&engine->mutex);
+    }
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+/**
+ * @brief 回调工作线程
+ *
+ * @param[in] arg: 引擎
+ *
+ * @return NULL
+ */
+static void *hs_timer_engine_worker(void *arg)
+{
+    hs_timer_engine_t *engine = (hs_timer_engine_t *)arg;
+    hs_timer_engine_work(engine, &engine->work_list, &engine->work_cond);
+
+    return NULL;
+}
+
+/**
+ * @brief 高优先级回调工作线程
+ *
+ * @param[in] arg: 引擎
+ *
+ * @return NULL
+ */
+static void *hs_timer_engine_high_worker(void *arg)
+{
+    hs_timer_engine_t *engine = (hs_timer_engine_t *)arg;
+    hs_timer_engine_work(engine, &engine->high_work_list, &engine->high_work_cond);
+
+    return NULL;
+}
+
+/**
+ * @brief 停止引擎的所有线程
+ *
+ * @param[in,out] engine      : 引擎
+ * @param[in]     has_thread  : 派发线程是否已启动
+ * @param[in]     worker_count: 已启动的回调工作线程数
+ */
+static void hs_timer_engine_stop(hs_timer_engine_t *engine, const bool has_thread, const uint32_t worker_count)
+{
+    pthread_mutex_lock(&engine->mutex);
+    __atomic_store_n(&engine->stopping, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&engine->work_cond);
+    pthread_cond_broadcast(&engine->high_work_cond);
+    pthread_mutex_unlock(&engine->mutex);
+
+    if (has_thread)
+    {
+        uint64_t value = 1;
+        write(engine->event_fd, &value, sizeof(value));
+        pthread_join(engine->thread, NULL);
+    }
+
+    for (uint32_t i = 0; i < worker_count; i++)
+    {
+        pthread_join(engine->workers[i], NULL);
+    }
+}
+
+/**
+ * @brief 启动引擎的所有线程
+ *
+ * @note 1. 绑定了 CPU 时，派发线程和回调工作线程都只在该 CPU 上运行
+ *       2. 失败时已启动的线程会全部停止
+ *
+ * @param[in,out] engine: 引擎
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_timer_engine_start(hs_timer_engine_t *engine)
+{
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0)
+    {
+        return -1;
+    }
+
+    if (engine->cpu != HS_TIMER_ENGINE_CPU_ANY)
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(engine->cpu, &cpu_set);
+        if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set), &cpu_set) != 0)
+        {
+            pthread_attr_destroy(&attr);
+
+            return -2;
+        }
+    }
+
+    int ret = 0;
+    uint32_t worker_count = 0;
+    for (; worker_count < engine->worker_count; worker_count++)
+    {
+        if (pthread_create(&engine->workers[worker_count], &attr, hs_timer_engine_worker, engine) != 0)
+        {
+            ret = -3;
+
+            break;
+        }
+    }
+
+    // 高优先级回调工作线程按配置使用实时调度
+    if ((ret == 0) && (engine->high_worker_policy != SCHED_OTHER))
+    {
+        struct sched_param param = {0};
+        param.sched_priority = engine->high_worker_sched_priority;
+        if ((pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) != 0) ||
+            (pthread_attr_setschedpolicy(&attr, engine->high_worker_policy) != 0) ||
+            (pthread_attr_setschedparam(&attr, &param) != 0))
+        {
+            ret = -4;
+        }
+    }
+    for (uint32_t i = 0; (ret == 0) && (i < engine->high_worker_count); i++, worker_count++)
+    {
+        if (pthread_create(&engine->workers[worker_count], &attr, hs_timer_engine_high_worker, engine) != 0)
+        {
+            ret = -3;
+        }
+    }
+
+    // 派发线程不使用实时调度
+    if ((ret == 0) && (engine->high_worker_policy != SCHED_OTHER))
+    {
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+    }
+
+    if ((ret == 0) && (engine->mode == E_HS_TIMER_ENGINE_MODE_THREAD) &&
+        (pthread_create(&engine->thread, &attr, hs_timer_engine_thread, engine) != 0))
+    {
+        ret = -3;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0)
+    {
+        hs_timer_engine_stop(engine, false, worker_count);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief 释放引擎资源
+ *
+ * @param[in,out] engine: 引擎
+ */
+static void hs_timer_engine_free(hs_timer_engine_t *engine)
+{
+    while (engine->groups != NULL)
+    {
+        hs_timer_engine_unlink_group(engine, engine->groups);
+    }
+    if (engine->timer_fd >= 0)
+    {
+        close(engine->timer_fd);
+    }
+    if (engine->event_fd >= 0)
+    {
+        close(engine->event_fd);
+    }
+    if (engine->poll_fd >= 0)
+    {
+        close(engine->poll_fd);
+    }
+    while (engine->slabs != NULL)
+    {
+        hs_timer_slab_t *next = engine->slabs->next;
+        free(engine->slabs);
+        engine->slabs = next;
+    }
+    pthread_cond_destroy(&engine->work_cond);
+    pthread_cond_destroy(&engine->high_work_cond);
+    pthread_cond_destroy(&engine->sync_cond);
+    pthread_mutex_destroy(&engine->mutex);
+    pthread_mutex_destroy(&engine->pool_mutex);
+    pthread_mutex_destroy(&engine->stats_mutex);
+    pthread_mutex_destroy(&engine->run_mutex);
+    hs_timer_heap_deinit(&engine->heap);
+    free(engine->stats_blocks);
+    free(engine->workers);
+    free(engine);
+}
+
+/**
+ * @brief 读取定时器快照
+ *
+ * @note 1. 不加锁，对象可能同时被回收或复用；读取前后分配序号不同时放弃本次读取
+ *       2. 启动序号在读取期间变化 (定时器被重新启动) 时重新读取，保证到期时间与其它字段一致
+ *       3. 分组成员在对象池互斥锁内读取分组时钟，释放定时器时在该锁内解除分组关联，锁内分配序号不变时分组仍存在
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in]     hs_timer: 定时器对象
+ * @param[in]     now_ns  : 当前时间 (引擎时钟, 单位: ns)
+ * @param[in]     locked  : 调用方是否已持有对象池互斥锁
+ * @param[out]    info    : 定时器快照
+ *
+ * @return true : 成功
+ * @return false: 定时器未使用或读取期间被复用
+ */
+static bool hs_timer_engine_snapshot(hs_timer_engine_t *engine, const hs_timer_t *hs_timer, const uint64_t now_ns,
+                                     const bool locked, hs_timer_info_t *info)
+{
+    for (uint32_t retry = 0; retry < 4; retry++)
+    {
+        uint32_t generation = __atomic_load_n(&hs_timer->generation, __ATOMIC_ACQUIRE);
+        uint32_t arm_seq = __atomic_load_n(&hs_timer->arm_seq, __ATOMIC_ACQUIRE);
+        hs_timer_status_e status = __atomic_load_n(&hs_timer->status, __ATOMIC_ACQUIRE);
+        switch (status)
+        {
+        case E_HS_TIMER_STATUS_CREATED:
+            info->state = E_HS_TIMER_STATE_CREATED;
+            break;
+
+        case E_HS_TIMER_STATUS_RUNNING:
+            info->state = E_HS_TIMER_STATE_RUNNING;
+            break;
+
+        case E_HS_TIMER_STATUS_PAUSED:
+            info->state = E_HS_TIMER_STATE_PAUSED;
+            break;
+
+        case E_HS_TIMER_STATUS_REQUEST_DESTROY:
+            info->state = E_HS_TIMER_STATE_DESTROYING;
+            break;
+
+        default:
+            return false;
+        }
+
+        // 分组成员的到期时间按分组时间计算
+        uint64_t deadline_ns = __atomic_load_n(&hs_timer->deadline_ns, __ATOMIC_ACQUIRE);
+        uint64_t clock_ns = now_ns;
+        if ((status == E_HS_TIMER_STATUS_RUNNING) && (__atomic_load_n(&hs_timer->group, __ATOMIC_RELAXED) != NULL))
+        {
+            if (!locked)
+            {
+                pthread_mutex_lock(&engine->pool_mutex);
+            }
+            hs_timer_group_t *group = __atomic_load_n(&hs_timer->group, __ATOMIC_RELAXED);
+            if ((group != NULL) && (__atomic_load_n(&hs_timer->generation, __ATOMIC_RELAXED) == generation))
+            {
+                uint64_t hold_ns = 0;
+                uint64_t offset_ns = 0;
+                clock_ns = hs_timer_group_read_clock(group, &hold_ns, &offset_ns)
+                               ? hold_ns
+                               : hs_timer_group_time_ns(hold_ns, offset_ns, now_ns);
+            }
+            if (!locked)
+            {
+                pthread_mutex_unlock(&engine->pool_mutex);
+            }
+        }
+        info->hs_timer = hs_timer;
+        info->timer_cb = __atomic_load_n(&hs_timer->timer_cb, __ATOMIC_ACQUIRE);
+        info->user_data = __atomic_load_n(&hs_timer->user_data, __ATOMIC_ACQUIRE);
+        info->timeout_ns = __atomic_load_n(&hs_timer->timeout_ns, __ATOMIC_ACQUIRE);
+        info->remaining_ns = ((status == E_HS_TIMER_STATUS_RUNNING) && (deadline_ns > clock_ns))
+                                 ? (deadline_ns - clock_ns)
+                                 : 0;
+        info->repeat_count = __atomic_load_n(&hs_timer->repeat_count, __ATOMIC_ACQUIRE);
+        info->periodic_mode = __atomic_load_n(&hs_timer->periodic_mode, __ATOMIC_ACQUIRE);
+        info->priority = __atomic_load_n(&hs_timer->priority, __ATOMIC_ACQUIRE);
+        info->is_static = hs_timer->is_static;
+
+        // 以上字段都以 acquire 顺序读取，再次读取的分配序号和启动序号不会提前到字段之前
+        if (__atomic_load_n(&hs_timer->generation, __ATOMIC_RELAXED) != generation)
+        {
+            return false;
+        }
+        if (__atomic_load_n(&hs_timer->arm_seq, __ATOMIC_RELAXED) == arm_seq)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 初始化分片引擎表
+ *
+ * @note 分片数量为系统配置的 CPU 数量
+ */
+static void hs_timer_engine_shard_init(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_CONF);
+    if (count < 1)
+    {
+        count = 1;
+    }
+    else if (count > CPU_SETSIZE)
+    {
+        count = CPU_SETSIZE;
+    }
+
+    s_shards = (hs_timer_engine_t **)calloc((size_t)count, sizeof(hs_timer_engine_t *));
+    if (s_shards != NULL)
+    {
+        s_shard_count = (uint32_t)count;
+    }
+}
+
+/**
+ * @brief 创建默认引擎
+ */
+static void hs_timer_engine_default_init(void)
+{
+    hs_timer_engine_config_t config = {0};
+    hs_timer_engine_config_init(&config);
+    config.worker_count = HS_TIMER_ENGINE_DEFAULT_WORKER_COUNT;
+
+    s_default_engine = hs_timer_engine_create(&config);
+    if (s_default_engine != NULL)
+    {
+        s_default_engine->is_builtin = true;
+    }
+}
+
+/**
+ * @brief 修复子进程中被父进程其它线程中断的定时器
+ *
+ * @note 1. 提交方已占用命令队列但未链入 (链入中断) 时，清除标志后重新提交
+ *       2. 已结束到期处理但未提交时补交
+ *       3. 等待同步销毁的线程在子进程中不存在，清除其完成标志
+ *       4. 请求销毁的一方在子进程中不存在，视为已取走销毁请求，没有待处理的命令时补交以便释放
+ *       5. 正在进行的调用在子进程中不存在，清除调用数和推迟释放的标志
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象 (状态不是 E_HS_TIMER_STATUS_UNUSED)
+ */
+static void hs_timer_engine_fixup_child(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if (hs_timer->release_done != HS_TIMER_RELEASED)
+    {
+        hs_timer->release_done = NULL;
+    }
+    hs_timer->in_flight = 0;
+
+    bool destroying = (hs_timer->status == E_HS_TIMER_STATUS_REQUEST_DESTROY);
+    if (destroying)
+    {
+        hs_timer->destroy_acked = true;
+    }
+
+    uint32_t state = __atomic_load_n(&hs_timer->cmd_state, __ATOMIC_RELAXED);
+    if (((state & HS_TIMER_CMD_QUEUED) != 0) && ((state & HS_TIMER_CMD_LINKED) == 0))
+    {
+        __atomic_store_n(&hs_timer->cmd_state, 0, __ATOMIC_RELAXED);
+        hs_timer_engine_submit(engine, hs_timer, 0);
+    }
+    else if ((state == 0) &&
+             ((hs_timer->in_dispatch && hs_timer->completed) || (destroying && !hs_timer->in_dispatch)))
+    {
+        // 已结束到期处理但还没来得及提交，或请求销毁后还没来得及提交
+        hs_timer_engine_submit(engine, hs_timer, 0);
+    }
+}
+
+/**
+ * @brief 在子进程中结束被中断的批量回调的其它成员
+ *
+ * @note 批量回调最后结束首个定时器的处理，首个定时器未结束时其它未结束的成员一定还属于这次批量回调
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in]     leader: 批量回调的首个定时器
+ */
+static void hs_timer_engine_abort_batch(hs_timer_engine_t *engine, const hs_timer_t *leader)
+{
+    for (hs_timer_slab_t *slab = engine->slabs; slab != NULL; slab = slab->next)
+    {
+        for (uint32_t i = 0; i < HS_TIMER_ENGINE_SLAB_TIMERS; i++)
+        {
+            hs_timer_t *hs_timer = &slab->timers[i];
+            if ((hs_timer != leader) && (hs_timer->status != E_HS_TIMER_STATUS_UNUSED) &&
+                (hs_timer->batch_leader == leader) && hs_timer->in_dispatch && !hs_timer->completed)
+            {
+                hs_timer_expire_abort(hs_timer);
+            }
+        }
+    }
+    for (hs_timer_t *hs_timer = engine->static_timers; hs_timer != NULL; hs_timer = hs_timer->static_next)
+    {
+        if ((hs_timer != leader) && (hs_timer->batch_leader == leader) && hs_timer->in_dispatch &&
+            !hs_timer->completed)
+        {
+            hs_timer_expire_abort(hs_timer);
+        }
+    }
+}
+
+/**
+ * @brief 在 fork() 后的子进程中重新初始化引擎
+ *
+ * @note 1. 父进程的线程在子进程中都不存在：重新初始化条件变量，重新创建描述符和引擎的线程
+ *       2. 回调工作线程中执行到一半的到期处理按回调已结束处理，周期定时器继续运行
+ *       3. 描述符或线程创建失败时引擎在子进程中不可用，没有其它补救办法
+ *
+ * @param[in,out] engine: 引擎 (引擎的互斥锁均未被持有)
+ */
+static void hs_timer_engine_reinit_child(hs_timer_engine_t *engine)
+{
+    pthread_cond_init(&engine->work_cond, NULL);
+    pthread_cond_init(&engine->high_work_cond, NULL);
+    pthread_cond_init(&engine->sync_cond, NULL);
+    engine->stopping = false;
+    engine->worker_started = 0;
+    engine->task_count = 0;
+    engine->wake_pending = false;
+    engine->wake_ns = 0;
+    engine->armed_tick = HS_TIMER_WHEEL_NEVER;
+    if (hs_timer_engine_open_fds(engine) != 0)
+    {
+        return;
+    }
+
+    // 已在命令队列或重试链表中的一定已链入，只是提交方可能还没来得及置位
+    for (hs_timer_t *hs_timer = engine->cmd_head; hs_timer != NULL; hs_timer = hs_timer->cmd_next)
+    {
+        hs_timer->cmd_state |= HS_TIMER_CMD_LINKED;
+    }
+    for (hs_timer_t *hs_timer = engine->cmd_retry_head; hs_timer != NULL; hs_timer = hs_timer->cmd_next)
+    {
+        hs_timer->cmd_state |= HS_TIMER_CMD_LINKED;
+    }
+
+    for (hs_timer_slab_t *slab = engine->slabs; slab != NULL; slab = slab->next)
+    {
+        for (uint32_t i = 0; i < HS_TIMER_ENGINE_SLAB_TIMERS; i++)
+        {
+            if (slab->timers[i].status != E_HS_TIMER_STATUS_UNUSED)
+            {
+                hs_timer_engine_fixup_child(engine, &slab->timers[i]);
+            }
+        }
+    }
+    for (hs_timer_t *hs_timer = engine->static_timers; hs_timer != NULL; hs_timer = hs_timer->static_next)
+    {
+        hs_timer_engine_fixup_child(engine, hs_timer);
+    }
+
+    // 派发方不在处理中，in_dispatch 可靠：回调工作线程中未结束的到期处理由这里结束
+    for (uint32_t i = 1; i <= engine->worker_count + engine->high_worker_count; i++)
+    {
+        hs_timer_engine_stats_block_t *block = &engine->stats_blocks[i];
+        hs_timer_t *hs_timer = block->running;
+        block->running = NULL;
+        if ((hs_timer != NULL) && (hs_timer->generation == block->running_generation) && hs_timer->in_dispatch &&
+            !hs_timer->completed)
+        {
+            if (hs_timer->batch_group != NULL)
+            {
+                hs_timer_engine_abort_batch(engine, hs_timer);
+            }
+            hs_timer_expire_abort(hs_timer);
+        }
+    }
+
+    hs_timer_engine_start(engine);
+    hs_timer_engine_wake(engine);
+}
+
+/**
+ * @brief fork() 前持有所有引擎的锁
+ *
+ * @note 1. 等待各引擎本轮派发处理结束，子进程中的时间轮、对象池等处于一致的状态
+ *       2. 在引擎的派发方或回调工作线程中调用 fork() 时不做任何处理，子进程中的引擎不可用
+ */
+static void hs_timer_engine_atfork_prepare(void)
+{
+    s_fork_skip = (s_stats_block != NULL);
+    if (s_fork_skip)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_shard_mutex);
+    pthread_mutex_lock(&s_engine_mutex);
+    for (hs_timer_engine_t *engine = s_engines; engine != NULL; engine = engine->engine_next)
+    {
+        pthread_mutex_lock(&engine->run_mutex);
+    }
+    for (hs_timer_engine_t *engine = s_engines; engine != NULL; engine = engine->engine_next)
+    {
+        pthread_mutex_lock(&engine->pool_mutex);
+        for (hs_timer_group_t *group = engine->all_groups; group != NULL; group = group->engine_next)
+        {
+            pthread_mutex_lock(&group->mutex);
+        }
+        pthread_mutex_lock(&engine->stats_mutex);
+        pthread_mutex_lock(&engine->mutex);
+    }
+}
+
+/**
+ * @brief 释放 fork() 前持有的锁
+ */
+static void hs_timer_engine_atfork_unlock(void)
+{
+    for (hs_timer_engine_t *engine = s_engines; engine != NULL; engine = engine->engine_next)
+    {
+        pthread_mutex_unlock(&engine->mutex);
+        pthread_mutex_unlock(&engine->stats_mutex);
+        for (hs_timer_group_t *group = engine->all_groups; group != NULL; group = group->engine_next)
+        {
+            pthread_mutex_unlock(&group->mutex);
+        }
+        pthread_mutex_unlock(&engine->pool_mutex);
+        pthread_mutex_unlock(&engine->run_mutex);
+    }
+    pthread_mutex_unlock(&s_engine_mutex);
+    pthread_mutex_unlock(&s_shard_mutex);
+}
+
+/**
+ * @brief fork() 后父进程中释放锁
+ */
+static void hs_timer_engine_atfork_parent(void)
+{
+    if (!s_fork_skip)
+    {
+        hs_timer_engine_atfork_unlock();
+    }
+}
+
+/**
+ * @brief fork() 后子进程中释放锁并重新初始化所有引擎
+ */
+static void hs_timer_engine_atfork_child(void)
+{
+    if (s_fork_skip)
+    {
+        return;
+    }
+
+    hs_timer_engine_atfork_unlock();
+    for (hs_timer_engine_t *engine = s_engines; engine != NULL; engine = engine->engine_next)
+    {
+        hs_timer_engine_reinit_child(engine);
+    }
+}
+
+/**
+ * @brief 注册 fork() 处理函数
+ */
+static void hs_timer_engine_atfork_init(void)
+{
+    pthread_atfork(hs_timer_engine_atfork_prepare, hs_timer_engine_atfork_parent, hs_timer_engine_atfork_child);
+}
+
+void hs_timer_engine_config_init(hs_timer_engine_config_t *config)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    memset(config, 0, sizeof(hs_timer_engine_config_t));
+    config->worker_count = HS_TIMER_ENGINE_DEFAULT_WORKER_COUNT;
+    config->tick_ns = HS_TIMER_ENGINE_DEFAULT_TICK_NS;
+    config->cpu = HS_TIMER_ENGINE_CPU_ANY;
+    config->backend = E_HS_TIMER_ENGINE_BACKEND_WHEEL;
+    config->compact_percent = HS_TIMER_ENGINE_COMPACT_PERCENT;
+    config->clock = E_HS_TIMER_ENGINE_CLOCK_MONOTONIC;
+}
+
+hs_timer_engine_t *hs_timer_engine_create(const hs_timer_engine_config_t *config)
+{
+    hs_timer_engine_config_t default_config = {0};
+    if (config == NULL)
+    {
+        hs_timer_engine_config_init(&default_config);
+        config = &default_config;
+    }
+
+    if ((config->cpu < HS_TIMER_ENGINE_CPU_ANY) || (config->cpu >= CPU_SETSIZE) ||
+        (config->backend > E_HS_TIMER_ENGINE_BACKEND_HYBRID) || (config->clock > E_HS_TIMER_ENGINE_CLOCK_TSC))
+    {
+        return NULL;
+    }
+
+    if (config->clock == E_HS_TIMER_ENGINE_CLOCK_TSC)
+    {
+        pthread_once(&s_tsc_once, hs_timer_engine_tsc_init);
+        if (!s_tsc.usable)
+        {
+            return NULL;
+        }
+    }
+
+    hs_timer_engine_t *engine = (hs_timer_engine_t *)calloc(1, sizeof(hs_timer_engine_t));
+    if (engine == NULL)
+    {
+        return NULL;
+    }
+
+    engine->tick_ns = (config->tick_ns != 0) ? config->tick_ns : HS_TIMER_ENGINE_DEFAULT_TICK_NS;
+    engine->slack_ns = config->slack_ns;
+    engine->armed_tick = HS_TIMER_WHEEL_NEVER;
+    engine->wake_ns = UINT64_MAX;
+    engine->mode = config->mode;
+    engine->backend = config->backend;
+    engine->executor_submit = config->executor_submit;
+    engine->executor_ctx = config->executor_ctx;
+    engine->dispatch_budget = config->dispatch_budget;
+    engine->dispatch_budget_ns = config->dispatch_budget_ns;
+    engine->cpu = config->cpu;
+    bool has_workers = ((engine->mode == E_HS_TIMER_ENGINE_MODE_THREAD) && (config->executor_submit == NULL));
+    engine->worker_count = has_workers ? config->worker_count : 0;
+    engine->high_worker_count = has_workers ? config->high_worker_count : 0;
+    engine->high_worker_policy = config->high_worker_policy;
+    engine->high_worker_sched_priority = config->high_worker_sched_priority;
+    engine->compact_percent = config->compact_percent;
+    engine->spin_ns = (engine->mode == E_HS_TIMER_ENGINE_MODE_THREAD) ? config->spin_ns : 0;
+    engine->clock = config->clock;
+    engine->clock_id = CLOCK_MONOTONIC;
+    engine->timer_clock_id = CLOCK_MONOTONIC;
+    if (engine->clock == E_HS_TIMER_ENGINE_CLOCK_COARSE)
+    {
+        // 粗粒度时钟每个内核节拍更新一次，最多落后一个节拍
+        struct timespec res = {0};
+        engine->clock_id = CLOCK_MONOTONIC_COARSE;
+        if (clock_getres(CLOCK_MONOTONIC_COARSE, &res) == 0)
+        {
+            engine->clock_lag_ns = ((uint64_t)res.tv_sec * HS_TIMER_NSEC_PER_SEC) + (uint64_t)res.tv_nsec;
+        }
+    }
+    else if (engine->clock == E_HS_TIMER_ENGINE_CLOCK_BOOTTIME)
+    {
+        engine->clock_id = CLOCK_BOOTTIME;
+        engine->timer_clock_id = CLOCK_BOOTTIME;
+    }
+    hs_timer_wheel_init(&engine->wheel, hs_timer_engine_now_ns(engine) / engine->tick_ns);
+    hs_timer_heap_init(&engine->heap);
+    pthread_mutex_init(&engine->mutex, NULL);
+    pthread_mutex_init(&engine->pool_mutex, NULL);
+    pthread_mutex_init(&engine->stats_mutex, NULL);
+    pthread_mutex_init(&engine->run_mutex, NULL);
+    pthread_cond_init(&engine->work_cond, NULL);
+    pthread_cond_init(&engine->high_work_cond, NULL);
+    pthread_cond_init(&engine->sync_cond, NULL);
+
+    engine->timer_fd = -1;
+    engine->event_fd = -1;
+    engine->poll_fd = -1;
+    if (hs_timer_engine_open_fds(engine) != 0)
+    {
+        hs_timer_engine_free(engine);
+
+        return NULL;
+    }
+
+    uint32_t thread_count = engine->worker_count + engine->high_worker_count;
+    if (thread_count > 0)
+    {
+        engine->workers = (pthread_t *)calloc(thread_count, sizeof(pthread_t));
+        if (engine->workers == NULL)
+        {
+            hs_timer_engine_free(engine);
+
+            return NULL;
+        }
+    }
+
+    size_t stats_size = sizeof(hs_timer_engine_stats_block_t) * (thread_count + 2);
+    void *stats_blocks = NULL;
+    if (posix_memalign(&stats_blocks, HS_TIMER_ENGINE_CACHE_LINE, stats_size) != 0)
+    {
+        hs_timer_engine_free(engine);
+
+        return NULL;
+    }
+    memset(stats_blocks, 0, stats_size);
+    engine->stats_blocks = (hs_timer_engine_stats_block_t *)stats_blocks;
+    for (uint32_t i = 0; i < thread_count + 2; i++)
+    {
+        engine->stats_blocks[i].engine = engine;
+    }
+
+    if (hs_timer_engine_start(engine) != 0)
+    {
+        hs_timer_engine_free(engine);
+
+        return NULL;
+    }
+
+    pthread_once(&s_atfork_once, hs_timer_engine_atfork_init);
+    pthread_mutex_lock(&s_engine_mutex);
+    engine->engine_next = s_engines;
+    if (s_engines != NULL)
+    {
+        s_engines->engine_prev = engine;
+    }
+    s_engines = engine;
+    pthread_mutex_unlock(&s_engine_mutex);
+
+    return engine;
+}
+
+int hs_timer_engine_destroy(hs_timer_engine_t *engine)
+{
+    if (engine == NULL)
+    {
+        return -1;
+    }
+
+    // 不能在该引擎的派发方中销毁引擎
+    if (engine->is_builtin || (s_current_engine == engine))
+    {
+        return -2;
+    }
+
+    // 已销毁的定时器由派发方异步释放，先等待已提交的命令处理完
+    hs_timer_engine_sync(engine);
+
+    pthread_mutex_lock(&engine->pool_mutex);
+    if (engine->timer_count != 0)
+    {
+        pthread_mutex_unlock(&engine->pool_mutex);
+
+        return -2;
+    }
+    pthread_mutex_unlock(&engine->pool_mutex);
+
+    // 定时器释放后执行器线程还可能在提交结束命令，任务只能由用户的执行器推进，不在这里等待
+    if (__atomic_load_n(&engine->task_count, __ATOMIC_ACQUIRE) != 0)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&s_engine_mutex);
+    if (engine->engine_prev != NULL)
+    {
+        engine->engine_prev->engine_next = engine->engine_next;
+    }
+    else
+    {
+        s_engines = engine->engine_next;
+    }
+    if (engine->engine_next != NULL)
+    {
+        engine->engine_next->engine_prev = engine->engine_prev;
+    }
+    pthread_mutex_unlock(&s_engine_mutex);
+
+    hs_timer_engine_stop(engine, (engine->mode == E_HS_TIMER_ENGINE_MODE_THREAD),
+                         engine->worker_count + engine->high_worker_count);
+    hs_timer_engine_free(engine);
+
+    return 0;
+}
+
+int hs_timer_engine_get_fd(const hs_timer_engine_t *engine)
+{
+    if (engine == NULL)
+    {
+        return -1;
+    }
+
+    if (engine->mode != E_HS_TIMER_ENGINE_MODE_EXTERNAL)
+    {
+        return -2;
+    }
+
+    // 同时包含 timerfd 和唤醒用的 eventfd，其它线程启动更早到期的定时器时也会变为可读
+    return engine->poll_fd;
+}
+
+int hs_timer_engine_process_expired(hs_timer_engine_t *engine)
+{
+    if (engine == NULL)
+    {
+        return -1;
+    }
+
+    // 回调中不能重入
+    if ((engine->mode != E_HS_TIMER_ENGINE_MODE_EXTERNAL) || (s_current_engine == engine))
+    {
+        return -2;
+    }
+
+    if (hs_timer_engine_clear_fds(engine) != 0)
+    {
+        return -3;
+    }
+
+    return (int)hs_timer_engine_run(engine);
+}
+
+int hs_timer_engine_get_stats(hs_timer_engine_t *engine, hs_timer_engine_stats_t *stats)
+{
+    if ((engine == NULL) || (stats == NULL))
+    {
+        return -1;
+    }
+
+    memset(stats, 0, sizeof(hs_timer_engine_stats_t));
+    for (uint32_t i = 0; i < engine->worker_count + engine->high_worker_count + 2; i++)
+    {
+        const hs_timer_engine_stats_block_t *block = &engine->stats_blocks[i];
+        stats->expired_count += __atomic_load_n(&block->expired_count, __ATOMIC_RELAXED);
+        stats->overrun_count += __atomic_load_n(&block->overrun_count, __ATOMIC_RELAXED);
+        hs_timer_histogram_merge(&stats->lateness, &block->lateness);
+        hs_timer_histogram_merge(&stats->callback, &block->callback);
+    }
+    stats->wakeup_count = __atomic_load_n(&engine->wakeup_count, __ATOMIC_RELAXED);
+    stats->active_count = __atomic_load_n(&engine->active_count, __ATOMIC_RELAXED);
+    stats->deferred_count = __atomic_load_n(&engine->ready_count, __ATOMIC_RELAXED);
+    stats->tombstone_count = __atomic_load_n(&engine->tombstone_count, __ATOMIC_RELAXED);
+    stats->tombstone_dropped = __atomic_load_n(&engine->tombstone_dropped, __ATOMIC_RELAXED);
+    stats->compact_count = __atomic_load_n(&engine->compact_count, __ATOMIC_RELAXED);
+    stats->compacted_count = __atomic_load_n(&engine->compacted_count, __ATOMIC_RELAXED);
+    stats->spin_count = __atomic_load_n(&engine->spin_count, __ATOMIC_RELAXED);
+    stats->spin_ns = __atomic_load_n(&engine->spin_total_ns, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&engine->pool_mutex);
+    stats->timer_count = engine->timer_count;
+    pthread_mutex_unlock(&engine->pool_mutex);
+
+    return 0;
+}
+
+int hs_timer_engine_foreach(hs_timer_engine_t *engine, const hs_timer_foreach_cb foreach_cb, void *arg)
+{
+    if ((engine == NULL) || (foreach_cb == NULL))
+    {
+        return -1;
+    }
+
+    uint64_t now_ns = hs_timer_engine_now_ns(engine);
+    int count = 0;
+    hs_timer_info_t info;
+
+    // 对象池的内存块在引擎销毁前不会释放，不加锁逐个读取
+    for (hs_timer_slab_t *slab = __atomic_load_n(&engine->slabs, __ATOMIC_ACQUIRE); slab != NULL; slab = slab->next)
+    {
+        for (uint32_t i = 0; i < HS_TIMER_ENGINE_SLAB_TIMERS; i++)
+        {
+            if (!hs_timer_engine_snapshot(engine, &slab->timers[i], now_ns, false, &info))
+            {
+                continue;
+            }
+
+            count++;
+            if (foreach_cb(&info, arg) != 0)
+            {
+                return count;
+            }
+        }
+    }
+
+    // 用户存储空间可能在回收后被释放，在锁内复制快照，回调时不持有锁
+    pthread_mutex_lock(&engine->pool_mutex);
+    hs_timer_info_t *infos = NULL;
+    uint64_t static_count = 0;
+    if (engine->static_count > 0)
+    {
+        infos = (hs_timer_info_t *)malloc(sizeof(hs_timer_info_t) * engine->static_count);
+        if (infos == NULL)
+        {
+            pthread_mutex_unlock(&engine->pool_mutex);
+
+            return -2;
+        }
+
+        for (hs_timer_t *hs_timer = engine->static_timers; hs_timer != NULL; hs_timer = hs_timer->static_next)
+        {
+            if (hs_timer_engine_snapshot(engine, hs_timer, now_ns, true, &infos[static_count]))
+            {
+                static_count++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&engine->pool_mutex);
+
+    for (uint64_t i = 0; i < static_count; i++)
+    {
+        count++;
+        if (foreach_cb(&infos[i], arg) != 0)
+        {
+            break;
+        }
+    }
+    free(infos);
+
+    return count;
+}
+
+hs_timer_engine_t *hs_timer_engine_default(void)
+{
+    pthread_once(&s_default_engine_once, hs_timer_engine_default_init);
+
+    return s_default_engine;
+}
+
+uint32_t hs_timer_engine_shard_count(void)
+{
+    pthread_once(&s_shard_once, hs_timer_engine_shard_init);
+
+    return s_shard_count;
+}
+
+hs_timer_engine_t *hs_timer_engine_shard(const uint32_t cpu)
+{
+    if (cpu >= hs_timer_engine_shard_count())
+    {
+        return NULL;
+    }
+
+    hs_timer_engine_t *engine = __atomic_load_n(&s_shards[cpu], __ATOMIC_ACQUIRE);
+    if (engine != NULL)
+    {
+        return engine;
+    }
+
+    pthread_mutex_lock(&s_shard_mutex);
+    engine = s_shards[cpu];
+    if (engine == NULL)
+    {
+        // 回调直接在绑定的派发线程中执行，定时器状态不会在 CPU 之间传递
+        hs_timer_engine_config_t config = {0};
+        hs_timer_engine_config_init(&config);
+        config.worker_count = 0;
+        config.cpu = (int32_t)cpu;
+
+        engine = hs_timer_engine_create(&config);
+        if (engine != NULL)
+        {
+            engine->is_builtin = true;
+            __atomic_store_n(&s_shards[cpu], engine, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&s_shard_mutex);
+
+    return engine;
+}
+
+hs_timer_engine_t *hs_timer_engine_shard_local(void)
+{
+    uint32_t shard_count = hs_timer_engine_shard_count();
+    if (shard_count == 0)
+    {
+        return NULL;
+    }
+
+    // 获取失败时使用第一个分片
+    int cpu = sched_getcpu();
+
+    return hs_timer_engine_shard((cpu < 0) ? 0 : ((uint32_t)cpu % shard_count));
+}
+
+uint64_t hs_timer_engine_now_ns(const hs_timer_engine_t *engine)
+{
+#ifdef HS_TIMER_ENGINE_HAS_TSC
+    if ((engine != NULL) && (engine->clock == E_HS_TIMER_ENGINE_CLOCK_TSC))
+    {
+        // 其它 CPU 上的计数可能略小于校准时的计数
+        uint64_t tsc = hs_timer_engine_read_tsc();
+        uint64_t delta = (tsc > s_tsc.base) ? (tsc - s_tsc.base) : 0;
+
+        return s_tsc.base_ns + (uint64_t)(((hs_timer_engine_u128_t)delta * s_tsc.mult) >> 32);
+    }
+#endif
+
+    struct timespec now = {0};
+    clock_gettime((engine != NULL) ? engine->clock_id : CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * HS_TIMER_NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+}
+
+void hs_timer_engine_notify(hs_timer_engine_t *engine)
+{
+    if ((engine == NULL) || (s_current_engine == engine))
+    {
+        return;
+    }
+
+    hs_timer_engine_wake(engine);
+}
+
+bool hs_timer_engine_is_dispatching(const hs_timer_engine_t *engine)
+{
+    return ((engine != NULL) && (s_current_engine == engine));
+}
+
+void hs_timer_engine_wait_release(hs_timer_engine_t *engine, const bool *release_done)
+{
+    if ((engine == NULL) || (release_done == NULL))
+    {
+        return;
+    }
+
+    // 与同步请求共用条件变量，各自检查自己的条件
+    pthread_mutex_lock(&engine->mutex);
+    while (!*release_done)
+    {
+        pthread_cond_wait(&engine->sync_cond, &engine->mutex);
+    }
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+hs_timer_t *hs_timer_engine_alloc_timer(hs_timer_engine_t *engine, hs_timer_storage_t *storage)
+{
+    if (engine == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&engine->pool_mutex);
+
+    hs_timer_t *hs_timer = NULL;
+    if (storage != NULL)
+    {
+        // 存储空间的状态由销毁流程最后写入，这里用原子操作占用，防止同一存储空间被重复创建
+        hs_timer = (hs_timer_t *)storage;
+        hs_timer_status_e expected = E_HS_TIMER_STATUS_UNUSED;
+        if (!__atomic_compare_exchange_n(&hs_timer->status, &expected, E_HS_TIMER_STATUS_CREATED, false,
+                                         __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            pthread_mutex_unlock(&engine->pool_mutex);
+
+            return NULL;
+        }
+        hs_timer->is_static = true;
+        hs_timer->static_prev = NULL;
+        hs_timer->static_next = engine->static_timers;
+        if (engine->static_timers != NULL)
+        {
+            engine->static_timers->static_prev = hs_timer;
+        }
+        engine->static_timers = hs_timer;
+        engine->static_count++;
+    }
+    else
+    {
+        if (engine->free_list == NULL)
+        {
+            hs_timer_slab_t *slab = (hs_timer_slab_t *)malloc(sizeof(hs_timer_slab_t));
+            if (slab == NULL)
+            {
+                pthread_mutex_unlock(&engine->pool_mutex);
+
+                return NULL;
+            }
+
+            for (uint32_t i = 0; i < HS_TIMER_ENGINE_SLAB_TIMERS; i++)
+            {
+                slab->timers[i].status = E_HS_TIMER_STATUS_UNUSED;
+                slab->timers[i].generation = 0;
+                slab->timers[i].in_flight = 0;
+                slab->timers[i].expire_next = engine->free_list;
+                engine->free_list = &slab->timers[i];
+            }
+
+            // 初始化完成后再加入链表，遍历时不会读到未初始化的定时器
+            slab->next = engine->slabs;
+            __atomic_store_n(&engine->slabs, slab, __ATOMIC_RELEASE);
+        }
+
+        hs_timer = engine->free_list;
+        engine->free_list = hs_timer->expire_next;
+        hs_timer->is_static = false;
+    }
+
+    __atomic_store_n(&hs_timer->generation, __atomic_load_n(&hs_timer->generation, __ATOMIC_RELAXED) + 1,
+                     __ATOMIC_RELEASE);
+    engine->timer_count++;
+    pthread_mutex_unlock(&engine->pool_mutex);
+
+    return hs_timer;
+}
+
+void hs_timer_engine_free_timer(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    HS_TIMER_TRACE(RELEASE, hs_timer, 0);
+
+    // 回调已结束且不会再执行，先让用户释放回调使用的资源
+    hs_timer_release_cb release_cb = __atomic_load_n(&hs_timer->release_cb, __ATOMIC_ACQUIRE);
+    if (release_cb != NULL)
+    {
+        release_cb(hs_timer);
+    }
+
+    // 释放后不能再访问定时器，先取出同步销毁的完成标志并换成哨兵，之后登记的同步销毁看到哨兵直接返回
+    bool *release_done = __atomic_exchange_n(&hs_timer->release_done, HS_TIMER_RELEASED, __ATOMIC_SEQ_CST);
+
+    // 先离开分组的成员链表，销毁分组时不会再访问该定时器
+    hs_timer_group_t *group = hs_timer->group;
+    if (group != NULL)
+    {
+        pthread_mutex_lock(&group->mutex);
+        if (hs_timer->group_prev != NULL)
+        {
+            hs_timer->group_prev->group_next = hs_timer->group_next;
+        }
+        else
+        {
+            group->members = hs_timer->group_next;
+        }
+        if (hs_timer->group_next != NULL)
+        {
+            hs_timer->group_next->group_prev = hs_timer->group_prev;
+        }
+        pthread_mutex_unlock(&group->mutex);
+    }
+
+    pthread_mutex_lock(&engine->pool_mutex);
+    // 在锁内清除分组，遍历定时器时持有该锁读取分组时钟
+    __atomic_store_n(&hs_timer->group, NULL, __ATOMIC_RELAXED);
+    if (hs_timer->is_static)
+    {
+        if (hs_timer->static_prev != NULL)
+        {
+            hs_timer->static_prev->static_next = hs_timer->static_next;
+        }
+        else
+        {
+            engine->static_timers = hs_timer->static_next;
+        }
+        if (hs_timer->static_next != NULL)
+        {
+            hs_timer->static_next->static_prev = hs_timer->static_prev;
+        }
+        engine->static_count--;
+
+        // 最后写入状态，之后用户可以复用存储空间
+        __atomic_store_n(&hs_timer->status, E_HS_TIMER_STATUS_UNUSED, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        // 遍历时跳过未使用的定时器
+        __atomic_store_n(&hs_timer->status, E_HS_TIMER_STATUS_UNUSED, __ATOMIC_RELEASE);
+        hs_timer->expire_next = engine->free_list;
+        engine->free_list = hs_timer;
+    }
+    engine->timer_count--;
+    pthread_mutex_unlock(&engine->pool_mutex);
+
+    // 引用计数归 0 后分组被释放，之后不能再访问分组
+    if (group != NULL)
+    {
+        hs_timer_group_unref(group);
+    }
+
+    if ((release_done != NULL) && (release_done != HS_TIMER_RELEASED))
+    {
+        pthread_mutex_lock(&engine->mutex);
+        *release_done = true;
+        pthread_cond_broadcast(&engine->sync_cond);
+        pthread_mutex_unlock(&engine->mutex);
+    }
+}
+
+void hs_timer_engine_add_group(hs_timer_engine_t *engine, hs_timer_group_t *group)
+{
+    if ((engine == NULL) || (group == NULL))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&engine->pool_mutex);
+    group->engine_prev = NULL;
+    group->engine_next = engine->all_groups;
+    if (engine->all_groups != NULL)
+    {
+        engine->all_groups->engine_prev = group;
+    }
+    engine->all_groups = group;
+    pthread_mutex_unlock(&engine->pool_mutex);
+}
+
+void hs_timer_engine_remove_group(hs_timer_engine_t *engine, hs_timer_group_t *group)
+{
+    if ((engine == NULL) || (group == NULL))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&engine->pool_mutex);
+    if (group->engine_prev != NULL)
+    {
+        group->engine_prev->engine_next = group->engine_next;
+    }
+    else
+    {
+        engine->all_groups = group->engine_next;
+    }
+    if (group->engine_next != NULL)
+    {
+        group->engine_next->engine_prev = group->engine_prev;
+    }
+    pthread_mutex_unlock(&engine->pool_mutex);
+}
+
+void hs_timer_engine_attach(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    hs_timer->engine = engine;
+    hs_timer->arm_seq = 0;
+    hs_timer->cmd_state = 0;
+    hs_timer->completed = false;
+    hs_timer->tombstone = false;
+    hs_timer->release_done = NULL;
+    hs_timer->release_cb = NULL;
+    hs_timer->cmd_next = NULL;
+    hs_timer_wheel_node_init(&hs_timer->node);
+    hs_timer_heap_node_init(&hs_timer->heap_node);
+    hs_timer->expire_next = NULL;
+    hs_timer->applied_seq = 0;
+    hs_timer->in_dispatch = false;
+    hs_timer->expire_pending = false;
+    hs_timer->destroy_acked = false;
+    hs_timer->expire_destroy = false;
+    hs_timer->slack_ns = engine->slack_ns;
+    hs_timer->group = NULL;
+    hs_timer->batch_next = NULL;
+    hs_timer->batch_leader = NULL;
+    hs_timer->batch_group = NULL;
+}
+
+/**
+ * @brief 向引擎提交定时器的状态变更
+ *
+ * @param[in,out] engine    : 引擎
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     wake_ns   : 同 hs_timer_engine_submit()
+ * @param[in]     push_flags: 额外置位的标志 (0 或 HS_TIMER_CMD_DESTROY)
+ */
+static void hs_timer_engine_submit_flags(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t wake_ns,
+                                         const uint32_t push_flags)
+{
+    uint32_t state = hs_timer_engine_claim(hs_timer, push_flags, wake_ns);
+    bool force_wake = false;
+    if ((state & HS_TIMER_CMD_QUEUED) == 0)
+    {
+        hs_timer_engine_push(engine, hs_timer, hs_timer);
+
+        // 最后一次访问定时器
+        state = __atomic_fetch_or(&hs_timer->cmd_state, HS_TIMER_CMD_LINKED, __ATOMIC_SEQ_CST);
+        force_wake = ((state & HS_TIMER_CMD_WAKE) != 0);
+    }
+    else if ((state & HS_TIMER_CMD_LINKED) == 0)
+    {
+        // 其它线程正在链入，由其负责唤醒
+        return;
+    }
+
+    // 派发方设置唤醒时间后会重新检查命令队列，两边都是顺序一致的读写，不会漏掉唤醒
+    if ((s_current_engine != engine) &&
+        (force_wake || (wake_ns < __atomic_load_n(&engine->wake_ns, __ATOMIC_SEQ_CST))))
+    {
+        hs_timer_engine_wake(engine);
+    }
+}
+
+void hs_timer_engine_submit(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t wake_ns)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    hs_timer_engine_submit_flags(engine, hs_timer, wake_ns, 0);
+}
+
+void hs_timer_engine_submit_destroy(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    hs_timer_engine_submit_flags(engine, hs_timer, 0, HS_TIMER_CMD_DESTROY);
+}
+
+void hs_timer_engine_enter(hs_timer_t *hs_timer)
+{
+    __atomic_add_fetch(&hs_timer->in_flight, 1, __ATOMIC_SEQ_CST);
+}
+
+void hs_timer_engine_leave(hs_timer_t *hs_timer)
+{
+    // 派发方推迟释放后，最后离开的调用把推迟标志换成解除中，派发方取走解除请求前不会释放
+    uint32_t parked = HS_TIMER_IN_FLIGHT_PARKED;
+    if ((__atomic_sub_fetch(&hs_timer->in_flight, 1, __ATOMIC_SEQ_CST) == parked) &&
+        __atomic_compare_exchange_n(&hs_timer->in_flight, &parked, HS_TIMER_IN_FLIGHT_UNPARKING, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+        hs_timer_engine_submit_flags(hs_timer->engine, hs_timer, 0, HS_TIMER_CMD_UNPARK);
+    }
+}
+
+void hs_timer_engine_complete(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t wake_ns)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    __atomic_store_n(&hs_timer->completed, true, __ATOMIC_RELEASE);
+    if ((s_stats_block != NULL) && (s_stats_block->running == hs_timer))
+    {
+        __atomic_store_n(&s_stats_block->running, NULL, __ATOMIC_RELEASE);
+    }
+    hs_timer_engine_submit(engine, hs_timer, wake_ns);
+}
+
+void hs_timer_engine_complete_destroy(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    __atomic_store_n(&hs_timer->completed, true, __ATOMIC_RELEASE);
+    if ((s_stats_block != NULL) && (s_stats_block->running == hs_timer))
+    {
+        __atomic_store_n(&s_stats_block->running, NULL, __ATOMIC_RELEASE);
+    }
+    hs_timer_engine_submit_flags(engine, hs_timer, 0, HS_TIMER_CMD_DESTROY);
+}
+
+void hs_timer_engine_record(hs_timer_engine_t *engine, const uint64_t lateness_ns, const uint64_t callback_ns,
+                            const uint32_t overrun)
+{
+    // 执行器的线程不属于该引擎，共用一个统计块，由互斥锁保证只有一个写入方
+    hs_timer_engine_stats_block_t *block = s_stats_block;
+    bool shared = ((block == NULL) || (block->engine != engine));
+    if (shared)
+    {
+        block = &engine->stats_blocks[engine->worker_count + engine->high_worker_count + 1];
+        pthread_mutex_lock(&engine->stats_mutex);
+    }
+
+    hs_timer_counter_add(&block->expired_count, 1);
+    hs_timer_counter_add(&block->overrun_count, overrun);
+    hs_timer_histogram_record(&block->lateness, lateness_ns);
+    hs_timer_histogram_record(&block->callback, callback_ns);
+
+    if (shared)
+    {
+        pthread_mutex_unlock(&engine->stats_mutex);
+    }
+}
+
+bool hs_timer_engine_mark_tombstone(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return false;
+    }
+
+    // 先计数再标记，清除方标记在前、计数在后，计数不会小于 0
+    __atomic_add_fetch(&engine->tombstone_count, 1, __ATOMIC_RELAXED);
+    if (__atomic_exchange_n(&hs_timer->tombstone, true, __ATOMIC_SEQ_CST))
+    {
+        __atomic_sub_fetch(&engine->tombstone_count, 1, __ATOMIC_RELAXED);
+
+        return false;
+    }
+
+    return true;
+}
+
+bool hs_timer_engine_clear_tombstone(hs_timer_engine_t *engine, hs_timer_t *hs_timer)
+{
+    if ((engine == NULL) || (hs_timer == NULL))
+    {
+        return false;
+    }
+
+    // 大多数定时器没有标记，只读一次
+    if (!__atomic_load_n(&hs_timer->tombstone, __ATOMIC_ACQUIRE) ||
+        !__atomic_exchange_n(&hs_timer->tombstone, false, __ATOMIC_SEQ_CST))
+    {
+        return false;
+    }
+    __atomic_sub_fetch(&engine->tombstone_count, 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+void hs_timer_engine_batch_init(hs_timer_engine_batch_t *batch)
+{
+    if (batch == NULL)
+    {
+        return;
+    }
+
+    memset(batch, 0, sizeof(hs_timer_engine_batch_t));
+}
+
+/**
+ * @brief 将定时器加入批量提交
+ *
+ * @param[in,out] batch     : 批量提交
+ * @param[in,out] hs_timer  : 定时器对象
+ * @param[in]     push_flags: 额外置位的标志 (0 或 HS_TIMER_CMD_DESTROY)
+ */
+static void hs_timer_engine_batch_add_flags(hs_timer_engine_batch_t *batch, hs_timer_t *hs_timer,
+                                            const uint32_t push_flags)
+{
+    if (batch->engine != hs_timer->engine)
+    {
+        hs_timer_engine_batch_commit(batch);
+        batch->engine = hs_timer->engine;
+    }
+    batch->count++;
+
+    // 整条链表一次入队，提交时总会唤醒派发方，可以提前置位 HS_TIMER_CMD_LINKED
+    uint32_t state = hs_timer_engine_claim(hs_timer, HS_TIMER_CMD_LINKED | push_flags, 0);
+    if ((state & HS_TIMER_CMD_QUEUED) != 0)
+    {
+        return;
+    }
+
+    hs_timer->cmd_next = batch->head;
+    batch->head = hs_timer;
+    if (batch->tail == NULL)
+    {
+        batch->tail = hs_timer;
+    }
+}
+
+void hs_timer_engine_batch_add(hs_timer_engine_batch_t *batch, hs_timer_t *hs_timer)
+{
+    if ((batch == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    hs_timer_engine_batch_add_flags(batch, hs_timer, 0);
+}
+
+void hs_timer_engine_batch_add_destroy(hs_timer_engine_batch_t *batch, hs_timer_t *hs_timer)
+{
+    if ((batch == NULL) || (hs_timer == NULL))
+    {
+        return;
+    }
+
+    hs_timer_engine_batch_add_flags(batch, hs_timer, HS_TIMER_CMD_DESTROY);
+}
+
+void hs_timer_engine_batch_commit(hs_timer_engine_batch_t *batch)
+{
+    if ((batch == NULL) || (batch->engine == NULL))
+    {
+        return;
+    }
+
+    if (batch->head != NULL)
+    {
+        hs_timer_engine_push(batch->engine, batch->head, batch->tail);
+    }
+
+    if ((batch->count > 0) && (s_current_engine != batch->engine))
+    {
+        hs_timer_engine_wake(batch->engine);
+    }
+
+    batch->head = NULL;
+    batch->tail = NULL;
+    batch->count = 0;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file      hs_timer_heap.c
+ * @brief     四叉最小堆源文件 (模块内部使用)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 16:37:34
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "hs_timer_heap.h"
+
+#define HS_TIMER_HEAP_MIN_CAPACITY (64U)                       // 堆数组的初始容量
+#define HS_TIMER_HEAP_PAD          (HS_TIMER_HEAP_ARITY - 1)   // 到期节拍数组前部的填充 (使子节点组 32 字节对齐)
+#define HS_TIMER_HEAP_ALIGN        (64U)                       // 到期节拍数组的对齐 (缓存行大小)
+
+/**
+ * @brief 将节点放到指定位置
+ *
+ * @param[in,out] heap   : 堆
+ * @param[in]     index  : 位置
+ * @param[in]     expires: 到期节拍
+ * @param[in,out] node   : 堆节点
+ */
+static inline void hs_timer_heap_place(hs_timer_heap_t *heap, const uint32_t index, const uint64_t expires,
+                                       hs_timer_heap_node_t *node)
+{
+    heap->expires[index] = expires;
+    heap->nodes[index] = node;
+    node->index = index;
+}
+
+/**
+ * @brief 找出一组 4 个子节点中到期节拍最小的一个
+ *
+ * @note 1. 子节点组 32 字节对齐，末尾不足 4 个时用 HS_TIMER_HEAP_NEVER 填充，可以一次读取整组
+ *       2. 编译时启用 AVX2 (x86) 或 NEON (AArch64) 时用向量指令比较，否则逐个比较；到期节拍相同时取下标小的
+ *
+ * @param[in] expires: 子节点组的到期节拍 (4 个)
+ *
+ * @return 最小子节点在组内的下标 (0 ~ 3)
+ */
+static inline uint32_t hs_timer_heap_min_child(const uint64_t *expires)
+{
+#if defined(__AVX2__)
+    // AVX2 只有有符号 64 位比较，翻转符号位后按有符号比较等价于无符号比较
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    __m256i value = _mm256_xor_si256(_mm256_load_si256((const __m256i *)expires), bias);
+    __m256i swap = _mm256_permute4x64_epi64(value, _MM_SHUFFLE(2, 3, 0, 1));
+    __m256i min = _mm256_blendv_epi8(value, swap, _mm256_cmpgt_epi64(value, swap));
+    swap = _mm256_permute4x64_epi64(min, _MM_SHUFFLE(1, 0, 3, 2));
+    min = _mm256_blendv_epi8(min, swap, _mm256_cmpgt_epi64(min, swap));
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(value, min)));
+
+    return (uint32_t)__builtin_ctz((unsigned int)mask);
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    uint64x2_t low = vld1q_u64(expires);
+    uint64x2_t high = vld1q_u64(expires + 2);
+    uint64x2_t pair = vbslq_u64(vcgtq_u64(low, high), high, low);
+    uint64_t min = vgetq_lane_u64(pair, 0);
+    if (vgetq_lane_u64(pair, 1) < min)
+    {
+        min = vgetq_lane_u64(pair, 1);
+    }
+
+    uint32_t child = 0;
+    while (expires[child] != min)
+    {
+        child++;
+    }
+
+    return child;
+#else
+    uint32_t child = 0;
+    for (uint32_t i = 1; i < HS_TIMER_HEAP_ARITY; i++)
+    {
+        if (expires[i] < expires[child])
+        {
+            child = i;
+        }
+    }
+
+    return child;
+#endif
+}
+
+/**
+ * @brief 将节点向上调整
+ *
+ * @param[in,out] heap   : 堆
+ * @param[in]     index  : 起始位置
+ * @param[in]     expires: 到期节拍
+ * @param[in,out] node   : 堆节点
+ */
+static void hs_timer_heap_sift_up(hs_timer_heap_t *heap, uint32_t index, const uint64_t expires,
+                                  hs_timer_heap_node_t *node)
+{
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / HS_TIMER_HEAP_ARITY;
+        if (heap->expires[parent] <= expires)
+        {
+            break;
+        }
+
+        hs_timer_heap_place(heap, index, heap->expires[parent], heap->nodes[parent]);
+        index = parent;
+    }
+
+    hs_timer_heap_place(heap, index, expires, node);
+}
+
+/**
+ * @brief 将节点向下调整
+ *
+ * @note 只比较到期节拍数组，4 个子节点的到期节拍共 32 字节，位于同一缓存行
+ *
+ * @param[in,out] heap   : 堆
+ * @param[in]     index  : 起始位置
+ * @param[in]     expires: 到期节拍
+ * @param[in,out] node   : 堆节点
+ */
+static void hs_timer_heap_sift_down(hs_timer_heap_t *heap, uint32_t index, const uint64_t expires,
+                                    hs_timer_heap_node_t *node)
+{
+    while (true)
+    {
+        uint32_t first = (index * HS_TIMER_HEAP_ARITY) + 1;
+        if (first >= heap->count)
+        {
+            break;
+        }
+
+        uint32_t child = first + hs_timer_heap_min_child(&heap->expires[first]);
+        if (expires <= heap->expires[child])
+        {
+            break;
+        }
+
+        hs_timer_heap_place(heap, index, heap->expires[child], heap->nodes[child]);
+        index = child;
+    }
+
+    hs_timer_heap_place(heap, index, expires, node);
+}
+
+/**
+ * @brief 移除指定位置的节点
+ *
+ * @param[in,out] heap : 堆
+ * @param[in]     index: 位置
+ */
+static void hs_timer_heap_remove(hs_timer_heap_t *heap, const uint32_t index)
+{
+    heap->nodes[index]->index = HS_TIMER_HEAP_INDEX_NONE;
+    heap->count--;
+
+    // 用最后一个节点填补空位，再向上或向下调整，腾出的位置恢复为填充值
+    uint64_t last_expires = heap->expires[heap->count];
+    hs_timer_heap_node_t *last_node = heap->nodes[heap->count];
+    heap->expires[heap->count] = HS_TIMER_HEAP_NEVER;
+    if (index == heap->count)
+    {
+        return;
+    }
+
+    if ((index > 0) && (last_expires < heap->expires[(index - 1) / HS_TIMER_HEAP_ARITY]))
+    {
+        hs_timer_heap_sift_up(heap, index, last_expires, last_node);
+    }
+    else
+    {
+        hs_timer_heap_sift_down(heap, index, last_expires, last_node);
+    }
+}
+
+/**
+ * @brief 扩大数组容量
+ *
+ * @param[in,out] heap: 堆
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_timer_heap_grow(hs_timer_heap_t *heap)
+{
+    if (heap->capacity >= (HS_TIMER_HEAP_INDEX_NONE / 2))
+    {
+        return -1;
+    }
+
+    uint32_t capacity = (heap->capacity == 0) ? HS_TIMER_HEAP_MIN_CAPACITY : (heap->capacity * 2);
+    hs_timer_heap_node_t **nodes =
+        (hs_timer_heap_node_t **)realloc(heap->nodes, sizeof(hs_timer_heap_node_t *) * capacity);
+    if (nodes == NULL)
+    {
+        return -2;
+    }
+    heap->nodes = nodes;
+
+    // 前部填充使子节点组对齐，末尾多留一组，读取最后一组子节点时不会越界
+    size_t slots = HS_TIMER_HEAP_PAD + capacity + HS_TIMER_HEAP_ARITY;
+    void *expires_mem = NULL;
+    if (posix_memalign(&expires_mem, HS_TIMER_HEAP_ALIGN, sizeof(uint64_t) * slots) != 0)
+    {
+        return -2;
+    }
+
+    uint64_t *expires = (uint64_t *)expires_mem + HS_TIMER_HEAP_PAD;
+    for (size_t i = 0; i < slots - HS_TIMER_HEAP_PAD; i++)
+    {
+        expires[i] = HS_TIMER_HEAP_NEVER;
+    }
+    if (heap->count > 0)
+    {
+        memcpy(expires, heap->expires, sizeof(uint64_t) * heap->count);
+    }
+    free(heap->expires_mem);
+    heap->expires_mem = expires_mem;
+    heap->expires = expires;
+    heap->capacity = capacity;
+
+    return 0;
+}
+
+void hs_timer_heap_init(hs_timer_heap_t *heap)
+{
+    heap->expires = NULL;
+    heap->nodes = NULL;
+    heap->expires_mem = NULL;
+    heap->count = 0;
+    heap->capacity = 0;
+}
+
+void hs_timer_heap_deinit(hs_timer_heap_t *heap)
+{
+    free(heap->expires_mem);
+    free(heap->nodes);
+    hs_timer_heap_init(heap);
+}
+
+void hs_timer_heap_node_init(hs_timer_heap_node_t *node)
+{
+    node->index = HS_TIMER_HEAP_INDEX_NONE;
+}
+
+bool hs_timer_heap_node_pending(const hs_timer_heap_node_t *node)
+{
+    return (node->index != HS_TIMER_HEAP_INDEX_NONE);
+}
+
+int hs_timer_heap_add(hs_timer_heap_t *heap, hs_timer_heap_node_t *node, const uint64_t expires)
+{
+    if ((heap->count == heap->capacity) && (hs_timer_heap_grow(heap) != 0))
+    {
+        return -1;
+    }
+
+    hs_timer_heap_sift_up(heap, heap->count++, expires, node);
+
+    return 0;
+}
+
+void hs_timer_heap_del(hs_timer_heap_t *heap, hs_timer_heap_node_t *node)
+{
+    if (!hs_timer_heap_node_pending(node))
+    {
+        return;
+    }
+
+    hs_timer_heap_remove(heap, node->index);
+}
+
+uint64_t hs_timer_heap_next_tick(const hs_timer_heap_t *heap)
+{
+    return (heap->count == 0) ? HS_TIMER_HEAP_NEVER : heap->expires[0];
+}
+
+void hs_timer_heap_advance(hs_timer_heap_t *heap, const uint64_t tick, const hs_timer_heap_expire_cb expire_cb,
+                           void *arg)
+{
+    while ((heap->count != 0) && (heap->expires[0] <= tick))
+    {
+        hs_timer_heap_node_t *node = heap->nodes[0];
+        hs_timer_heap_remove(heap, 0);
+
+        if (expire_cb != NULL)
+        {
+            expire_cb(node, arg);
+        }
+    }
+}
+
+void hs_timer_heap_purge(hs_timer_heap_t *heap, const hs_timer_heap_purge_cb purge_cb, void *arg)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < heap->count; i++)
+    {
+        hs_timer_heap_node_t *node = heap->nodes[i];
+        if (purge_cb(node, arg))
+        {
+            node->index = HS_TIMER_HEAP_INDEX_NONE;
+
+            continue;
+        }
+
+        hs_timer_heap_place(heap, count++, heap->expires[i], node);
+    }
+
+    // 腾出的位置恢复为填充值
+    for (uint32_t i = count; i < heap->count; i++)
+    {
+        heap->expires[i] = HS_TIMER_HEAP_NEVER;
+    }
+    heap->count = count;
+
+    // 从最后一个有子节点的节点开始逐个向下调整
+    if (count > 1)
+    {
+        for (uint32_t i = ((count - 2) / HS_TIMER_HEAP_ARITY) + 1; i-- > 0;)
+        {
+            hs_timer_heap_sift_down(heap, i, heap->expires[i], heap->nodes[i]);
+        }
+    }
+}
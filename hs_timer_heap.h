@@ -0,0 +1,157 @@
+/**
+ * @file      hs_timer_heap.h
+ * @brief     四叉最小堆头文件 (模块内部使用)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 16:37:20
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_TIMER_HEAP_H
+#define __HS_TIMER_HEAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HS_TIMER_HEAP_ARITY      (4U)         // 每个节点的子节点数
+#define HS_TIMER_HEAP_INDEX_NONE (UINT32_MAX) // 节点不在堆中
+#define HS_TIMER_HEAP_NEVER      (UINT64_MAX) // 无到期节拍 (同时用于填充末尾不足 4 个的子节点组)
+
+// 堆节点 (内嵌在定时器对象中)
+typedef struct hs_timer_heap_node
+{
+    uint32_t index; // 在堆数组中的位置 (HS_TIMER_HEAP_INDEX_NONE: 不在堆中)
+} hs_timer_heap_node_t;
+
+// 四叉最小堆 (到期节拍与节点分开存放，比较时只访问连续的到期节拍数组)
+typedef struct hs_timer_heap
+{
+    uint64_t *expires;            // 到期节拍数组 (同一节点的 4 个子节点位于 32 字节对齐的连续位置)
+    hs_timer_heap_node_t **nodes; // 节点数组 (与 expires 按下标一一对应)
+    void *expires_mem;            // 到期节拍数组的内存 (按缓存行对齐分配)
+    uint32_t count;               // 节点数量
+    uint32_t capacity;            // 数组容量
+} hs_timer_heap_t;
+
+/**
+ * @brief 到期节点处理函数
+ *
+ * @param[in,out] node: 已从堆中移除的到期节点
+ * @param[in,out] arg : 用户参数
+ */
+typedef void (*hs_timer_heap_expire_cb)(hs_timer_heap_node_t *node, void *arg);
+
+/**
+ * @brief 清理节点判断函数
+ *
+ * @note 不能在函数中修改堆
+ *
+ * @param[in,out] node: 堆节点
+ * @param[in,out] arg : 用户参数
+ *
+ * @return true : 从堆中移除该节点
+ * @return false: 保留该节点
+ */
+typedef bool (*hs_timer_heap_purge_cb)(hs_timer_heap_node_t *node, void *arg);
+
+/**
+ * @brief 初始化堆
+ *
+ * @note 堆数组在第一次添加节点时分配
+ *
+ * @param[out] heap: 堆
+ */
+void hs_timer_heap_init(hs_timer_heap_t *heap);
+
+/**
+ * @brief 释放堆数组
+ *
+ * @param[in,out] heap: 堆
+ */
+void hs_timer_heap_deinit(hs_timer_heap_t *heap);
+
+/**
+ * @brief 初始化堆节点
+ *
+ * @param[out] node: 堆节点
+ */
+void hs_timer_heap_node_init(hs_timer_heap_node_t *node);
+
+/**
+ * @brief 节点是否在堆中
+ *
+ * @param[in] node: 堆节点
+ *
+ * @return true : 在
+ * @return false: 不在
+ */
+bool hs_timer_heap_node_pending(const hs_timer_heap_node_t *node);
+
+/**
+ * @brief 添加节点
+ *
+ * @note 节点必须不在堆中
+ *
+ * @param[in,out] heap   : 堆
+ * @param[in,out] node   : 堆节点
+ * @param[in]     expires: 到期节拍
+ *
+ * @return 0 : 成功
+ * @return <0: 失败 (堆数组扩容失败)
+ */
+int hs_timer_heap_add(hs_timer_heap_t *heap, hs_timer_heap_node_t *node, const uint64_t expires);
+
+/**
+ * @brief 删除节点
+ *
+ * @note 节点不在堆中时，直接返回
+ *
+ * @param[in,out] heap: 堆
+ * @param[in,out] node: 堆节点
+ */
+void hs_timer_heap_del(hs_timer_heap_t *heap, hs_timer_heap_node_t *node);
+
+/**
+ * @brief 获取最早的到期节拍
+ *
+ * @param[in] heap: 堆
+ *
+ * @return 最早的到期节拍 (HS_TIMER_HEAP_NEVER: 堆为空)
+ */
+uint64_t hs_timer_heap_next_tick(const hs_timer_heap_t *heap);
+
+/**
+ * @brief 取出到期的节点
+ *
+ * @note 处理函数中可以重新添加节点，到期节拍不晚于 tick 的节点会在本次继续取出
+ *
+ * @param[in,out] heap     : 堆
+ * @param[in]     tick     : 当前节拍 (到期节拍不晚于该节拍的节点到期)
+ * @param[in]     expire_cb: 到期节点处理函数
+ * @param[in,out] arg      : 用户参数
+ */
+void hs_timer_heap_advance(hs_timer_heap_t *heap, const uint64_t tick, const hs_timer_heap_expire_cb expire_cb,
+                           void *arg);
+
+/**
+ * @brief 移除满足条件的节点
+ *
+ * @note 先原地筛掉要移除的节点再整体重建堆，复杂度为 O(n)，与移除的数量无关
+ *
+ * @param[in,out] heap    : 堆
+ * @param[in]     purge_cb: 清理节点判断函数
+ * @param[in,out] arg     : 用户参数
+ */
+void hs_timer_heap_purge(hs_timer_heap_t *heap, const hs_timer_heap_purge_cb purge_cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_TIMER_HEAP_H
@@ -0,0 +1,524 @@
+/**
+ * @file      hs_timer_internal.h
+ * @brief     定时器模块内部头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 09:20:11
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_TIMER_INTERNAL_H
+#define __HS_TIMER_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "hs_timer.h"
+#include "hs_timer_wheel.h"
+#include "hs_timer_heap.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 根据成员指针获取外层结构体指针
+#define HS_TIMER_CONTAINER_OF(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+
+#define HS_TIMER_NSEC_PER_MSEC (1000000ULL)    // 每毫秒的纳秒数
+#define HS_TIMER_NSEC_PER_SEC  (1000000000ULL) // 每秒的纳秒数
+
+// 定时器状态
+typedef enum hs_timer_status
+{
+    E_HS_TIMER_STATUS_UNUSED = 0,      // 未使用 (静态存储空间可以复用)
+    E_HS_TIMER_STATUS_CREATED,         // 已创建
+    E_HS_TIMER_STATUS_RUNNING,         // 运行中
+    E_HS_TIMER_STATUS_PAUSED,          // 已暂停
+    E_HS_TIMER_STATUS_REQUEST_DESTROY, // 请求销毁
+} hs_timer_status_e;
+
+#ifdef HS_TIMER_ENABLE_TRACE
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+// USDT 探针，未挂载时为一条 nop
+#define HS_TIMER_TRACE_PROBE(event, timer, arg) DTRACE_PROBE2(hs_timer, event, timer, arg)
+#endif
+#endif
+#ifndef HS_TIMER_TRACE_PROBE
+#define HS_TIMER_TRACE_PROBE(event, timer, arg) ((void)0)
+#endif
+
+// 跟踪回调函数 (NULL: 未设置)
+extern hs_timer_trace_cb g_hs_timer_trace_cb;
+
+// 跟踪点: 探针加上一次原子读取和一次预测为不成立的分支
+#define HS_TIMER_TRACE(event, timer, arg)                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        HS_TIMER_TRACE_PROBE(event, timer, arg);                                                                       \
+        hs_timer_trace_cb trace_cb_ = __atomic_load_n(&g_hs_timer_trace_cb, __ATOMIC_ACQUIRE);                         \
+        if (__builtin_expect(trace_cb_ != NULL, 0))                                                                    \
+        {                                                                                                              \
+            trace_cb_(E_HS_TIMER_TRACE_##event, (timer), (uint64_t)(arg));                                             \
+        }                                                                                                              \
+    } while (0)
+#else
+// 未启用跟踪时不产生代码，参数不求值
+#define HS_TIMER_TRACE(event, timer, arg)                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        (void)sizeof(timer);                                                                                           \
+        (void)sizeof(arg);                                                                                             \
+    } while (0)
+#endif
+
+#define HS_TIMER_ENGINE_WAKE_NONE (UINT64_MAX) // 提交命令后不需要唤醒派发方
+
+#define HS_TIMER_CMD_QUEUED  (1U << 0) // 已在或正在加入命令队列
+#define HS_TIMER_CMD_LINKED  (1U << 1) // 已链入命令队列 (派发方可以取走)
+#define HS_TIMER_CMD_WAKE    (1U << 2) // 链入前有其它提交或派发方已取出，链入方需要唤醒派发方
+#define HS_TIMER_CMD_DESTROY (1U << 3) // 包含销毁请求 (请求销毁的一方提交后不再访问定时器，派发方取走后才能释放)
+#define HS_TIMER_CMD_UNPARK  (1U << 4) // 包含解除推迟释放的请求 (见 HS_TIMER_IN_FLIGHT_UNPARKING)
+
+#define HS_TIMER_IN_FLIGHT_PARKED    (1U << 31) // 派发方因有调用未结束而推迟了释放，最后离开的调用负责解除
+#define HS_TIMER_IN_FLIGHT_UNPARKING (1U << 30) // 最后离开的调用已提交 HS_TIMER_CMD_UNPARK，派发方取走前不能释放
+#define HS_TIMER_IN_FLIGHT_COUNT     (HS_TIMER_IN_FLIGHT_UNPARKING - 1U) // 正在进行的调用数
+
+#define HS_TIMER_RELEASED ((bool *)1) // 同步销毁的完成标志位置上的哨兵: 派发方已开始释放，不会再读取完成标志
+
+// 定时器对象
+struct _hs_timer
+{
+    // 以下成员可被多个线程同时访问，统一使用 __atomic 内建函数读写
+    hs_timer_status_e status;               // 定时器状态 (进入 E_HS_TIMER_STATUS_REQUEST_DESTROY 后不再改变)
+    hs_timer_cb timer_cb;                   // 定时器回调函数
+    uint32_t repeat_count;                  // 定时器重复次数 (1: 执行一次; UINT32_MAX: 无限循环)
+    uint64_t timeout_ns;                    // 定时器超时时间 (单位: ns)
+    const void *user_data;                  // 用户数据
+    hs_timer_periodic_mode_e periodic_mode; // 周期调度策略
+    hs_timer_priority_e priority;           // 优先级
+    uint64_t deadline_ns;                   // 最近一次启动的到期时间 (引擎时钟, 单位: ns)
+    uint32_t overrun;                       // 本次回调合并或跳过的周期数
+    uint32_t pending_overrun;               // 下一次回调合并或跳过的周期数
+    uint64_t slack_ns;                      // 允许延后到期的时间 (单位: ns)
+    uint32_t arm_seq;                       // 启动序号 (写入 deadline_ns 后以 release 顺序加一)
+    uint32_t cmd_state;                     // 命令队列状态 (HS_TIMER_CMD_XXX 按位或, 0: 不在队列中)
+    uint32_t in_flight;                     // 已开始、尚未提交完的调用数与 HS_TIMER_IN_FLIGHT_XXX 标志 (释放后不清零)
+    hs_timer_stats_t stats;                 // 定时器统计 (只由到期处理流程写入)
+    bool *release_done;                     // 同步销毁的完成标志 (释放后由派发方在引擎互斥锁内置位; NULL: 无人等待; HS_TIMER_RELEASED: 已开始释放)
+    hs_timer_release_cb release_cb;         // 释放回调函数 (回收前由派发方调用)
+    uint32_t generation;                    // 分配序号 (每次分配加一，遍历时用于识别对象已被复用)
+    bool completed;                         // 到期处理是否已结束 (等待派发方确认)
+    bool tombstone;                         // 是否为延迟取消留下的墓碑 (派发方移除或重新启动时清除)
+    bool expire_destroy;                    // 是否由到期处理请求了销毁 (只由执行到期处理的线程访问)
+    hs_timer_group_t *group;                // 所属分组 (创建时写入，释放时清除; NULL: 不属于分组)
+    struct _hs_timer *group_prev;           // 分组成员链表的上一个 (由分组互斥锁保护)
+    struct _hs_timer *group_next;           // 分组成员链表的下一个 (由分组互斥锁保护)
+
+    // 以下成员只由引擎的派发方访问
+    hs_timer_engine_t *engine;      // 所属引擎 (分配后不变)
+    bool is_static;                 // 是否使用用户提供的存储空间 (分配后不变)
+    struct _hs_timer *static_prev;  // 用户存储空间上的定时器链表的上一个 (由引擎的对象池互斥锁保护)
+    struct _hs_timer *static_next;  // 用户存储空间上的定时器链表的下一个 (由引擎的对象池互斥锁保护)
+    struct _hs_timer *cmd_next;     // 命令队列的下一个定时器 (入队时由提交方写入)
+    hs_timer_wheel_node_t node;     // 时间轮节点
+    hs_timer_heap_node_t heap_node; // 堆节点
+    struct _hs_timer *expire_next;  // 到期链表的下一个定时器
+    uint64_t expire_ns;             // 有序到期链表的排序键 (合并时换算的引擎时间, 单位: ns; UINT64_MAX: 分组已暂停)
+    uint32_t applied_seq;           // 时间轮中已生效的启动序号
+    bool in_dispatch;               // 是否已从时间轮取出、等待或正在执行到期处理
+    bool expire_pending;            // 到期处理期间是否再次到期
+    bool destroy_acked;             // 是否已取走销毁请求 (请求销毁的一方不再访问定时器，可以释放)
+    struct _hs_timer *batch_next;   // 同一次批量回调的下一个定时器
+    struct _hs_timer *batch_leader; // 所在批量回调的首个定时器 (NULL: 单独执行)
+    hs_timer_group_t *batch_group;  // 本次到期按批量回调执行的分组 (仅批量回调的首个定时器; NULL: 单独执行)
+
+    // 内嵌数据区 (只由用户访问)
+    union
+    {
+        uint8_t data[HS_TIMER_INLINE_DATA_SIZE]; // 数据
+        uint64_t align_u64;                      // 对齐
+        void *align_ptr;                         // 对齐
+    } inline_data;
+};
+
+/**
+ * @brief 累加计数
+ *
+ * @note 只有一个线程写入，其它线程可以同时读取，不需要原子的读改写
+ *
+ * @param[in,out] counter: 计数
+ * @param[in]     value  : 增量
+ */
+static inline void hs_timer_counter_add(uint64_t *counter, const uint64_t value)
+{
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+// 定时器分组
+// 成员的到期时间按分组时间计算：分组时间 = max(hold_ns, 引擎时间 - offset_ns)，暂停时固定为 hold_ns
+struct _hs_timer_group
+{
+    // 以下成员创建后不变
+    hs_timer_engine_t *engine;  // 所属引擎
+    hs_timer_group_cb batch_cb; // 批量回调函数 (NULL: 成员按各自的回调函数执行)
+    void *ctx;                  // 传给 batch_cb 的用户参数
+
+    // 以下成员统一使用 __atomic 内建函数读写
+    uint32_t ref_count; // 引用计数 (用户句柄、每个成员、派发方的分组链表各一个，归 0 时释放)
+    uint32_t clock_seq; // 分组时钟序号 (写入期间为奇数，读取方据此读取一致的时钟)
+    bool paused;        // 分组时钟是否已暂停
+    uint64_t hold_ns;   // 分组时间的下限 (暂停时即为分组时间)
+    uint64_t offset_ns; // 引擎时间与分组时间之差
+
+    pthread_mutex_t mutex; // 分组互斥锁 (保护以下成员，并串行化分组时钟的写入)
+    hs_timer_t *members;   // 成员链表 (通过 group_next 连接)
+    uint64_t delay_ns;     // 暂停期间推迟的时间 (恢复时生效)
+
+    struct _hs_timer_group *engine_prev; // 引擎的全部分组链表的上一个 (由引擎的对象池互斥锁保护)
+    struct _hs_timer_group *engine_next; // 引擎的全部分组链表的下一个 (由引擎的对象池互斥锁保护)
+
+    // 以下成员只由引擎的派发方访问
+    hs_timer_wheel_t wheel;             // 分组时间轮 (按分组时间计算节拍，分组暂停时不推进)
+    bool linked;                        // 是否在引擎的分组链表中
+    struct _hs_timer_group *prev;       // 引擎的分组链表的上一个
+    struct _hs_timer_group *next;       // 引擎的分组链表的下一个
+    hs_timer_t *batch_head;             // 本次派发到期的成员 (通过 batch_next 连接)
+    hs_timer_t *batch_tail;             // 本次派发到期的最后一个成员
+    struct _hs_timer_group *batch_link; // 本次派发有成员到期的分组链表的下一个
+};
+
+// 批量提交 (同一引擎的定时器预先连接成链表，一次加入命令队列)
+typedef struct hs_timer_engine_batch
+{
+    hs_timer_engine_t *engine; // 当前引擎
+    hs_timer_t *head;          // 链表头 (最后加入的定时器)
+    hs_timer_t *tail;          // 链表尾 (最先加入的定时器)
+    uint32_t count;            // 加入的定时器数量 (包括已在命令队列中的)
+} hs_timer_engine_batch_t;
+
+/**
+ * @brief 获取默认引擎
+ *
+ * @note 首次调用时创建，之后一直存在
+ *
+ * @return 成功: 默认引擎
+ * @return 失败: NULL
+ */
+hs_timer_engine_t *hs_timer_engine_default(void);
+
+/**
+ * @brief 唤醒引擎的派发方重新计算下一次唤醒时间
+ *
+ * @param[in,out] engine: 引擎
+ */
+void hs_timer_engine_notify(hs_timer_engine_t *engine);
+
+/**
+ * @brief 将分组加入引擎的全部分组链表
+ *
+ * @note fork() 前持有链表中所有分组的互斥锁，子进程中分组时钟和成员链表处于一致的状态
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in,out] group : 定时器分组
+ */
+void hs_timer_engine_add_group(hs_timer_engine_t *engine, hs_timer_group_t *group);
+
+/**
+ * @brief 将分组从引擎的全部分组链表中移除
+ *
+ * @param[in,out] engine: 引擎
+ * @param[in,out] group : 定时器分组
+ */
+void hs_timer_engine_remove_group(hs_timer_engine_t *engine, hs_timer_group_t *group);
+
+/**
+ * @brief 读取分组时钟
+ *
+ * @note 不加锁，与写入并发时重新读取
+ *
+ * @param[in]  group    : 定时器分组
+ * @param[out] hold_ns  : 分组时间的下限
+ * @param[out] offset_ns: 引擎时间与分组时间之差
+ *
+ * @return true : 已暂停 (分组时间固定为 hold_ns)
+ * @return false: 未暂停
+ */
+bool hs_timer_group_read_clock(const hs_timer_group_t *group, uint64_t *hold_ns, uint64_t *offset_ns);
+
+/**
+ * @brief 将引擎时间换算为分组时间
+ *
+ * @param[in] hold_ns  : 分组时间的下限
+ * @param[in] offset_ns: 引擎时间与分组时间之差
+ * @param[in] now_ns   : 引擎时间
+ *
+ * @return 分组时间 (单位: ns)
+ */
+static inline uint64_t hs_timer_group_time_ns(const uint64_t hold_ns, const uint64_t offset_ns, const uint64_t now_ns)
+{
+    return ((now_ns > offset_ns) && ((now_ns - offset_ns) > hold_ns)) ? (now_ns - offset_ns) : hold_ns;
+}
+
+/**
+ * @brief 获取分组时钟的当前时间
+ *
+ * @param[in] group: 定时器分组
+ *
+ * @return 当前分组时间 (单位: ns)
+ */
+uint64_t hs_timer_group_now_ns(const hs_timer_group_t *group);
+
+/**
+ * @brief 释放分组的一个引用
+ *
+ * @note 引用计数归 0 时释放分组
+ *
+ * @param[in,out] group: 定时器分组
+ */
+void hs_timer_group_unref(hs_timer_group_t *group);
+
+/**
+ * @brief 当前线程是否正在作为引擎的派发方
+ *
+ * @note 为 true 时当前线程不能等待派发方，否则会死锁
+ *
+ * @param[in] engine: 引擎
+ *
+ * @return true : 是
+ * @return false: 否
+ */
+bool hs_timer_engine_is_dispatching(const hs_timer_engine_t *engine);
+
+/**
+ * @brief 等待派发方释放定时器
+ *
+ * @note 调用前定时器的 release_done 已指向 release_done，且已请求销毁
+ *
+ * @param[in,out] engine      : 引擎
+ * @param[in]     release_done: 完成标志
+ */
+void hs_timer_engine_wait_release(hs_timer_engine_t *engine, const bool *release_done);
+
+/**
+ * @brief 分配定时器对象
+ *
+ * @note 1. storage 为 NULL 时从引擎的对象池中分配，否则使用用户提供的存储空间
+ *       2. 用户提供的存储空间仍被占用 (状态不是 E_HS_TIMER_STATUS_UNUSED) 时分配失败
+ *
+ * @param[in,out] engine : 引擎
+ * @param[in,out] storage: 用户提供的存储空间
+ *
+ * @return 成功: 定时器对象 (除 is_static 外未初始化)
+ * @return 失败: NULL
+ */
+hs_timer_t *hs_timer_engine_alloc_timer(hs_timer_engine_t *engine, hs_timer_storage_t *storage);
+
+/**
+ * @brief 释放定时器对象
+ *
+ * @note 对象池中的定时器放回空闲链表，用户存储空间上的定时器标记为未使用
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象 (已从引擎中移除)
+ */
+void hs_timer_engine_free_timer(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 将定时器添加到引擎
+ *
+ * @note 1. 定时器尚未提交给引擎，派发方不会同时访问
+ *       2. 定时器的 slack_ns 初始化为引擎的默认值
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_attach(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 向引擎提交定时器的状态变更
+ *
+ * @note 1. 调用前先写入定时器的新状态，派发方处理命令时读取最新状态，多次提交只处理一次
+ *       2. 不加锁，只有 wake_ns 早于派发方下一次唤醒时间时才通过 eventfd 唤醒派发方
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     wake_ns : 需要派发方处理的最晚时间 (引擎时钟, 单位: ns; 0: 立即;
+ *                          HS_TIMER_ENGINE_WAKE_NONE: 下一次唤醒时处理即可)
+ */
+void hs_timer_engine_submit(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t wake_ns);
+
+/**
+ * @brief 向引擎提交定时器的销毁请求
+ *
+ * @note 1. 切换到 E_HS_TIMER_STATUS_REQUEST_DESTROY 成功的一方必须调用，之后不能再访问该定时器
+ *       2. 派发方取走该请求前不会释放定时器，切换状态和提交之间定时器不会被回收
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_submit_destroy(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 开始一次会在切换状态后继续访问定时器的调用
+ *
+ * @note 1. 重复次数用完时到期处理会自动销毁定时器，调用方无法预知；在切换状态前调用，之后引擎不会释放该定时器，
+ *          直到调用 hs_timer_engine_leave()
+ *       2. 对已经释放的定时器调用也不会出错，只是之后的状态检查会失败
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_enter(hs_timer_t *hs_timer);
+
+/**
+ * @brief 结束 hs_timer_engine_enter() 开始的调用
+ *
+ * @note 引擎因该调用推迟了释放时，由最后离开的调用提交解除请求，之后不能再访问该定时器
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_leave(hs_timer_t *hs_timer);
+
+/**
+ * @brief 标记定时器为墓碑
+ *
+ * @note 由 hs_timer_cancel_lazy() 在切换状态前调用，引擎的墓碑计数始终不少于已标记的定时器数量
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return true : 本次新标记
+ * @return false: 之前已标记
+ */
+bool hs_timer_engine_mark_tombstone(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 清除定时器的墓碑标记
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ *
+ * @return true : 清除成功
+ * @return false: 没有标记 (或已被其它线程清除)
+ */
+bool hs_timer_engine_clear_tombstone(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 开始批量提交
+ *
+ * @param[out] batch: 批量提交
+ */
+void hs_timer_engine_batch_init(hs_timer_engine_batch_t *batch);
+
+/**
+ * @brief 将定时器加入批量提交
+ *
+ * @note 1. 调用前先写入定时器的新状态
+ *       2. 定时器与之前加入的定时器不属于同一引擎时，先提交之前的定时器
+ *
+ * @param[in,out] batch   : 批量提交
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_batch_add(hs_timer_engine_batch_t *batch, hs_timer_t *hs_timer);
+
+/**
+ * @brief 将定时器的销毁请求加入批量提交
+ *
+ * @note 同 hs_timer_engine_submit_destroy()，加入后不能再访问该定时器
+ *
+ * @param[in,out] batch   : 批量提交
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_batch_add_destroy(hs_timer_engine_batch_t *batch, hs_timer_t *hs_timer);
+
+/**
+ * @brief 提交批量中的全部定时器
+ *
+ * @note 每个引擎只入队一次、最多唤醒一次派发方
+ *
+ * @param[in,out] batch: 批量提交 (提交后清空，可以继续使用)
+ */
+void hs_timer_engine_batch_commit(hs_timer_engine_batch_t *batch);
+
+/**
+ * @brief 结束定时器的到期处理
+ *
+ * @note 1. 由到期处理流程在最后调用，之后不能再访问该定时器 (派发方可能已将其释放)
+ *       2. 到期处理期间再次到期时，派发方会立即重新执行到期处理
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ * @param[in]     wake_ns : 同 hs_timer_engine_submit()
+ */
+void hs_timer_engine_complete(hs_timer_engine_t *engine, hs_timer_t *hs_timer, const uint64_t wake_ns);
+
+/**
+ * @brief 结束定时器的到期处理，并提交到期处理流程自己的销毁请求
+ *
+ * @note 到期处理流程切换到 E_HS_TIMER_STATUS_REQUEST_DESTROY 成功时，用该函数代替 hs_timer_engine_complete()
+ *
+ * @param[in,out] engine  : 引擎
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_engine_complete_destroy(hs_timer_engine_t *engine, hs_timer_t *hs_timer);
+
+/**
+ * @brief 记录一次到期处理的统计
+ *
+ * @note 记录到当前回调执行线程的统计块中，执行器的线程共用一个统计块
+ *
+ * @param[in,out] engine     : 引擎
+ * @param[in]     lateness_ns: 回调开始时间相对到期时间的延迟 (单位: ns)
+ * @param[in]     callback_ns: 回调耗时 (单位: ns)
+ * @param[in]     overrun    : 合并或跳过的周期数
+ */
+void hs_timer_engine_record(hs_timer_engine_t *engine, const uint64_t lateness_ns, const uint64_t callback_ns,
+                            const uint32_t overrun);
+
+/**
+ * @brief 记录直方图样本
+ *
+ * @note 只有一个线程写入，其它线程可以同时读取
+ *
+ * @param[in,out] hist : 直方图
+ * @param[in]     value: 样本值 (单位: ns)
+ */
+void hs_timer_histogram_record(hs_timer_histogram_t *hist, const uint64_t value);
+
+/**
+ * @brief 将直方图累加到另一个直方图
+ *
+ * @param[in,out] dst: 目标直方图
+ * @param[in]     src: 被累加的直方图 (可能正在被其它线程写入)
+ */
+void hs_timer_histogram_merge(hs_timer_histogram_t *dst, const hs_timer_histogram_t *src);
+
+/**
+ * @brief 定时器到期处理
+ *
+ * @note 由引擎在派发线程、回调工作线程或执行器的线程中调用
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_expire(hs_timer_t *hs_timer);
+
+/**
+ * @brief 结束定时器的到期处理 (不执行回调函数)
+ *
+ * @note 1. 按回调函数已执行完处理：重启周期定时器，或交给引擎释放
+ *       2. 用于 fork() 后的子进程中结束被中断的到期处理，hs_timer_expire() 也用它结束处理
+ *
+ * @param[in,out] hs_timer: 定时器对象
+ */
+void hs_timer_expire_abort(hs_timer_t *hs_timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_TIMER_INTERNAL_H
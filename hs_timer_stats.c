@@ -0,0 +1,127 @@
+/**
+ * @file      hs_timer_stats.c
+ * @brief     定时器统计源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 15:42:08
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+
+#include "hs_timer_internal.h"
+
+#define HS_TIMER_HISTOGRAM_SUB_BITS  (2U)                                 // 每个 2 的幂区间细分桶数的位宽
+#define HS_TIMER_HISTOGRAM_SUB_COUNT (1U << HS_TIMER_HISTOGRAM_SUB_BITS) // 每个 2 的幂区间细分的桶数
+
+/**
+ * @brief 计算样本所在的桶
+ *
+ * @note 小于 HS_TIMER_HISTOGRAM_SUB_COUNT 的值每个值一个桶，其余按最高位所在的 2 的幂区间再等分
+ *
+ * @param[in] value: 样本值
+ *
+ * @return 桶索引
+ */
+static uint32_t hs_timer_histogram_index(const uint64_t value)
+{
+    if (value < HS_TIMER_HISTOGRAM_SUB_COUNT)
+    {
+        return (uint32_t)value;
+    }
+
+    uint32_t msb = (uint32_t)(63 - __builtin_clzll(value));
+    uint32_t sub = (uint32_t)(value >> (msb - HS_TIMER_HISTOGRAM_SUB_BITS)) & (HS_TIMER_HISTOGRAM_SUB_COUNT - 1);
+
+    return ((msb - HS_TIMER_HISTOGRAM_SUB_BITS + 1) << HS_TIMER_HISTOGRAM_SUB_BITS) + sub;
+}
+
+/**
+ * @brief 获取桶的上界
+ *
+ * @param[in] index: 桶索引
+ *
+ * @return 桶内的最大值
+ */
+static uint64_t hs_timer_histogram_upper(const uint32_t index)
+{
+    if (index < HS_TIMER_HISTOGRAM_SUB_COUNT)
+    {
+        return index;
+    }
+
+    uint32_t msb = (index >> HS_TIMER_HISTOGRAM_SUB_BITS) + HS_TIMER_HISTOGRAM_SUB_BITS - 1;
+    uint64_t sub = index & (HS_TIMER_HISTOGRAM_SUB_COUNT - 1);
+    uint64_t width = 1ULL << (msb - HS_TIMER_HISTOGRAM_SUB_BITS);
+
+    return (1ULL << msb) + (sub * width) + (width - 1);
+}
+
+void hs_timer_histogram_record(hs_timer_histogram_t *hist, const uint64_t value)
+{
+    hs_timer_counter_add(&hist->count, 1);
+    hs_timer_counter_add(&hist->sum_ns, value);
+    hs_timer_counter_add(&hist->buckets[hs_timer_histogram_index(value)], 1);
+    if (value > __atomic_load_n(&hist->max_ns, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&hist->max_ns, value, __ATOMIC_RELAXED);
+    }
+}
+
+void hs_timer_histogram_merge(hs_timer_histogram_t *dst, const hs_timer_histogram_t *src)
+{
+    dst->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+    dst->sum_ns += __atomic_load_n(&src->sum_ns, __ATOMIC_RELAXED);
+
+    uint64_t max_ns = __atomic_load_n(&src->max_ns, __ATOMIC_RELAXED);
+    if (max_ns > dst->max_ns)
+    {
+        dst->max_ns = max_ns;
+    }
+
+    for (uint32_t i = 0; i < HS_TIMER_HISTOGRAM_BUCKETS; i++)
+    {
+        dst->buckets[i] += __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+    }
+}
+
+uint64_t hs_timer_histogram_percentile(const hs_timer_histogram_t *hist, const double percentile)
+{
+    if (hist == NULL)
+    {
+        return 0;
+    }
+
+    // 读取时可能有样本正在写入，以各桶之和为准
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < HS_TIMER_HISTOGRAM_BUCKETS; i++)
+    {
+        total += hist->buckets[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    double ratio = (percentile <= 0.0) ? 0.0 : ((percentile >= 100.0) ? 1.0 : (percentile / 100.0));
+    uint64_t target = (uint64_t)((double)total * ratio);
+    if (target == 0)
+    {
+        target = 1;
+    }
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < HS_TIMER_HISTOGRAM_BUCKETS; i++)
+    {
+        sum += hist->buckets[i];
+        if (sum >= target)
+        {
+            uint64_t upper = hs_timer_histogram_upper(i);
+
+            return ((hist->max_ns != 0) && (upper > hist->max_ns)) ? hist->max_ns : upper;
+        }
+    }
+
+    return hist->max_ns;
+}
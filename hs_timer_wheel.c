@@ -0,0 +1,280 @@
+/**
+ * @file      hs_timer_wheel.c
+ * @brief     分层时间轮源文件 (模块内部使用)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 09:12:52
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "hs_timer_wheel.h"
+
+/**
+ * @brief 计算节点所在槽位
+ *
+ * @param[in] level  : 层
+ * @param[in] expires: 到期节拍
+ *
+ * @return 槽位
+ */
+static inline uint32_t hs_timer_wheel_calc_slot(const uint32_t level, const uint64_t expires)
+{
+    return (uint32_t)((expires >> (level * HS_TIMER_WHEEL_LEVEL_BITS)) & HS_TIMER_WHEEL_LEVEL_MASK);
+}
+
+/**
+ * @brief 将节点挂入对应槽位
+ *
+ * @note 层由到期节拍与当前节拍的差值决定，差值越大所在层越高
+ *
+ * @param[in,out] wheel: 时间轮
+ * @param[in,out] node : 时间轮节点 (expires 已设置)
+ */
+static void hs_timer_wheel_link(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node)
+{
+    // 已过期的节点放到当前节拍，下一次推进时到期
+    if (node->expires < wheel->tick)
+    {
+        node->expires = wheel->tick;
+    }
+
+    uint64_t delta = node->expires - wheel->tick;
+    if (delta > HS_TIMER_WHEEL_MAX_DELTA)
+    {
+        delta = HS_TIMER_WHEEL_MAX_DELTA;
+        node->expires = wheel->tick + delta;
+    }
+
+    uint32_t level = 0;
+    if (delta != 0)
+    {
+        level = (uint32_t)(63 - __builtin_clzll(delta)) / HS_TIMER_WHEEL_LEVEL_BITS;
+    }
+    uint32_t slot = hs_timer_wheel_calc_slot(level, node->expires);
+
+    hs_timer_wheel_node_t **head = &wheel->slots[level][slot];
+    node->next = *head;
+    if (node->next != NULL)
+    {
+        node->next->pprev = &node->next;
+    }
+    node->pprev = head;
+    *head = node;
+
+    node->level = (uint8_t)level;
+    node->slot = (uint8_t)slot;
+    wheel->bitmap[level] |= (1ULL << slot);
+}
+
+/**
+ * @brief 将节点从槽位中摘除
+ *
+ * @param[in,out] wheel: 时间轮
+ * @param[in,out] node : 时间轮节点 (必须在时间轮中)
+ */
+static void hs_timer_wheel_unlink(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node)
+{
+    *node->pprev = node->next;
+    if (node->next != NULL)
+    {
+        node->next->pprev = node->pprev;
+    }
+
+    if (wheel->slots[node->level][node->slot] == NULL)
+    {
+        wheel->bitmap[node->level] &= ~(1ULL << node->slot);
+    }
+
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+/**
+ * @brief 取出整个槽位的链表
+ *
+ * @param[in,out] wheel: 时间轮
+ * @param[in]     level: 层
+ * @param[in]     slot : 槽位
+ *
+ * @return 槽位链表头 (链表中节点的 pprev 未清理)
+ */
+static hs_timer_wheel_node_t *hs_timer_wheel_detach_slot(hs_timer_wheel_t *wheel, const uint32_t level,
+                                                         const uint32_t slot)
+{
+    hs_timer_wheel_node_t *head = wheel->slots[level][slot];
+    wheel->slots[level][slot] = NULL;
+    wheel->bitmap[level] &= ~(1ULL << slot);
+
+    return head;
+}
+
+/**
+ * @brief 级联高层槽位
+ *
+ * @note 当前节拍的低位全部为 0 时，把高层对应槽位的节点重新分配到低层
+ *
+ * @param[in,out] wheel: 时间轮 (tick 为当前处理的节拍)
+ */
+static void hs_timer_wheel_cascade(hs_timer_wheel_t *wheel)
+{
+    for (uint32_t level = 1; level < HS_TIMER_WHEEL_LEVEL_DEPTH; level++)
+    {
+        uint32_t slot = hs_timer_wheel_calc_slot(level, wheel->tick);
+        hs_timer_wheel_node_t *node = hs_timer_wheel_detach_slot(wheel, level, slot);
+        while (node != NULL)
+        {
+            hs_timer_wheel_node_t *next = node->next;
+            hs_timer_wheel_link(wheel, node);
+            node = next;
+        }
+
+        // 该层的索引没有回绕，更高层不需要级联
+        if (slot != 0)
+        {
+            break;
+        }
+    }
+}
+
+void hs_timer_wheel_init(hs_timer_wheel_t *wheel, const uint64_t tick)
+{
+    memset(wheel, 0, sizeof(hs_timer_wheel_t));
+    wheel->tick = tick;
+}
+
+void hs_timer_wheel_node_init(hs_timer_wheel_node_t *node)
+{
+    node->next = NULL;
+    node->pprev = NULL;
+    node->expires = 0;
+    node->level = 0;
+    node->slot = 0;
+}
+
+bool hs_timer_wheel_node_pending(const hs_timer_wheel_node_t *node)
+{
+    return (node->pprev != NULL);
+}
+
+void hs_timer_wheel_add(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node, const uint64_t expires)
+{
+    node->expires = expires;
+    hs_timer_wheel_link(wheel, node);
+    wheel->count++;
+}
+
+void hs_timer_wheel_del(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node)
+{
+    if (!hs_timer_wheel_node_pending(node))
+    {
+        return;
+    }
+
+    hs_timer_wheel_unlink(wheel, node);
+    wheel->count--;
+}
+
+uint64_t hs_timer_wheel_next_tick(const hs_timer_wheel_t *wheel)
+{
+    uint64_t next_tick = HS_TIMER_WHEEL_NEVER;
+
+    for (uint32_t level = 0; level < HS_TIMER_WHEEL_LEVEL_DEPTH; level++)
+    {
+        uint64_t bitmap = wheel->bitmap[level];
+        if (bitmap == 0)
+        {
+            continue;
+        }
+
+        // 以本层粒度表示的、下一个会被处理的位置 (第 0 层为当前节拍，其余层为下一个级联边界)
+        uint32_t shift = level * HS_TIMER_WHEEL_LEVEL_BITS;
+        uint64_t base = (wheel->tick + (1ULL << shift) - 1) >> shift;
+        uint32_t index = (uint32_t)(base & HS_TIMER_WHEEL_LEVEL_MASK);
+
+        // 从 index 开始循环查找第一个非空槽位
+        uint64_t rotated = bitmap >> index;
+        if (index != 0)
+        {
+            rotated |= bitmap << (HS_TIMER_WHEEL_LEVEL_SIZE - index);
+        }
+        uint64_t tick = (base + (uint64_t)__builtin_ctzll(rotated)) << shift;
+
+        if (tick < next_tick)
+        {
+            next_tick = tick;
+        }
+    }
+
+    return next_tick;
+}
+
+void hs_timer_wheel_advance(hs_timer_wheel_t *wheel, const uint64_t tick, const hs_timer_wheel_expire_cb expire_cb,
+                            void *arg)
+{
+    while (wheel->tick <= tick)
+    {
+        // 中间没有级联和到期的节拍全部跳过
+        uint64_t next_tick = hs_timer_wheel_next_tick(wheel);
+        if (next_tick > tick)
+        {
+            wheel->tick = tick + 1;
+
+            return;
+        }
+        wheel->tick = next_tick;
+
+        if ((wheel->tick & HS_TIMER_WHEEL_LEVEL_MASK) == 0)
+        {
+            hs_timer_wheel_cascade(wheel);
+        }
+
+        hs_timer_wheel_node_t *node =
+            hs_timer_wheel_detach_slot(wheel, 0, hs_timer_wheel_calc_slot(0, wheel->tick));
+        wheel->tick++;
+
+        while (node != NULL)
+        {
+            hs_timer_wheel_node_t *next = node->next;
+            node->next = NULL;
+            node->pprev = NULL;
+            wheel->count--;
+
+            if (expire_cb != NULL)
+            {
+                expire_cb(node, arg);
+            }
+
+            node = next;
+        }
+    }
+}
+
+void hs_timer_wheel_purge(hs_timer_wheel_t *wheel, const hs_timer_wheel_purge_cb purge_cb, void *arg)
+{
+    for (uint32_t level = 0; level < HS_TIMER_WHEEL_LEVEL_DEPTH; level++)
+    {
+        uint64_t bitmap = wheel->bitmap[level];
+        while (bitmap != 0)
+        {
+            uint32_t slot = (uint32_t)__builtin_ctzll(bitmap);
+            bitmap &= bitmap - 1;
+
+            hs_timer_wheel_node_t *node = wheel->slots[level][slot];
+            while (node != NULL)
+            {
+                hs_timer_wheel_node_t *next = node->next;
+                if (purge_cb(node, arg))
+                {
+                    hs_timer_wheel_unlink(wheel, node);
+                    wheel->count--;
+                }
+
+                node = next;
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file      hs_timer_wheel.h
+ * @brief     分层时间轮头文件 (模块内部使用)
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-14 09:12:40
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_TIMER_WHEEL_H
+#define __HS_TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HS_TIMER_WHEEL_LEVEL_BITS  (6U)                                   // 每层槽位数的位宽
+#define HS_TIMER_WHEEL_LEVEL_SIZE  (1U << HS_TIMER_WHEEL_LEVEL_BITS)      // 每层槽位数
+#define HS_TIMER_WHEEL_LEVEL_MASK  (HS_TIMER_WHEEL_LEVEL_SIZE - 1)        // 槽位掩码
+#define HS_TIMER_WHEEL_LEVEL_DEPTH (8U)                                   // 层数
+#define HS_TIMER_WHEEL_MAX_DELTA   ((1ULL << (HS_TIMER_WHEEL_LEVEL_BITS * HS_TIMER_WHEEL_LEVEL_DEPTH)) - 1)
+#define HS_TIMER_WHEEL_NEVER       (UINT64_MAX)                           // 无到期节拍
+
+// 时间轮节点 (内嵌在定时器对象中)
+typedef struct hs_timer_wheel_node
+{
+    struct hs_timer_wheel_node *next;   // 槽位链表的下一个节点
+    struct hs_timer_wheel_node **pprev; // 指向前一个节点 next 成员的指针 (NULL: 不在时间轮中)
+    uint64_t expires;                   // 到期节拍
+    uint8_t level;                      // 所在层
+    uint8_t slot;                       // 所在槽位
+} hs_timer_wheel_node_t;
+
+// 分层时间轮
+typedef struct hs_timer_wheel
+{
+    uint64_t tick;                                                                   // 下一个待处理的节拍
+    uint64_t count;                                                                  // 节点数量
+    uint64_t bitmap[HS_TIMER_WHEEL_LEVEL_DEPTH];                                     // 非空槽位位图
+    hs_timer_wheel_node_t *slots[HS_TIMER_WHEEL_LEVEL_DEPTH][HS_TIMER_WHEEL_LEVEL_SIZE]; // 槽位链表
+} hs_timer_wheel_t;
+
+/**
+ * @brief 到期节点处理函数
+ *
+ * @param[in,out] node: 已从时间轮中移除的到期节点
+ * @param[in,out] arg : 用户参数
+ */
+typedef void (*hs_timer_wheel_expire_cb)(hs_timer_wheel_node_t *node, void *arg);
+
+/**
+ * @brief 清理节点判断函数
+ *
+ * @note 不能在函数中修改时间轮
+ *
+ * @param[in,out] node: 时间轮节点
+ * @param[in,out] arg : 用户参数
+ *
+ * @return true : 从时间轮中移除该节点
+ * @return false: 保留该节点
+ */
+typedef bool (*hs_timer_wheel_purge_cb)(hs_timer_wheel_node_t *node, void *arg);
+
+/**
+ * @brief 初始化时间轮
+ *
+ * @param[out] wheel: 时间轮
+ * @param[in]  tick : 起始节拍
+ */
+void hs_timer_wheel_init(hs_timer_wheel_t *wheel, const uint64_t tick);
+
+/**
+ * @brief 初始化时间轮节点
+ *
+ * @param[out] node: 时间轮节点
+ */
+void hs_timer_wheel_node_init(hs_timer_wheel_node_t *node);
+
+/**
+ * @brief 节点是否在时间轮中
+ *
+ * @param[in] node: 时间轮节点
+ *
+ * @return true : 在
+ * @return false: 不在
+ */
+bool hs_timer_wheel_node_pending(const hs_timer_wheel_node_t *node);
+
+/**
+ * @brief 添加节点
+ *
+ * @note 1. 节点必须不在时间轮中
+ *       2. 到期节拍早于当前节拍时，会在下一次推进时到期
+ *
+ * @param[in,out] wheel  : 时间轮
+ * @param[in,out] node   : 时间轮节点
+ * @param[in]     expires: 到期节拍
+ */
+void hs_timer_wheel_add(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node, const uint64_t expires);
+
+/**
+ * @brief 删除节点
+ *
+ * @note 节点不在时间轮中时，直接返回
+ *
+ * @param[in,out] wheel: 时间轮
+ * @param[in,out] node : 时间轮节点
+ */
+void hs_timer_wheel_del(hs_timer_wheel_t *wheel, hs_timer_wheel_node_t *node);
+
+/**
+ * @brief 获取下一个需要处理的节拍
+ *
+ * @note 返回值可能是高层槽位的级联节拍，此时该节拍上不一定有节点到期
+ *
+ * @param[in] wheel: 时间轮
+ *
+ * @return 下一个需要处理的节拍 (HS_TIMER_WHEEL_NEVER: 时间轮为空)
+ */
+uint64_t hs_timer_wheel_next_tick(const hs_timer_wheel_t *wheel);
+
+/**
+ * @brief 推进时间轮
+ *
+ * @note 跳过没有节点的节拍，空闲时间再长也不会逐个节拍处理
+ *
+ * @param[in,out] wheel    : 时间轮
+ * @param[in]     tick     : 推进到的节拍 (包含该节拍)
+ * @param[in]     expire_cb: 到期节点处理函数
+ * @param[in,out] arg      : 用户参数
+ */
+void hs_timer_wheel_advance(hs_timer_wheel_t *wheel, const uint64_t tick, const hs_timer_wheel_expire_cb expire_cb,
+                            void *arg);
+
+/**
+ * @brief 移除满足条件的节点
+ *
+ * @note 只遍历非空槽位，节点的到期节拍和所在槽位保持不变
+ *
+ * @param[in,out] wheel   : 时间轮
+ * @param[in]     purge_cb: 清理节点判断函数
+ * @param[in,out] arg     : 用户参数
+ */
+void hs_timer_wheel_purge(hs_timer_wheel_t *wheel, const hs_timer_wheel_purge_cb purge_cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_TIMER_WHEEL_H